@@ -0,0 +1,117 @@
+package io.github.readmigo.pagecurl.benchmark
+
+import android.graphics.PointF
+import androidx.benchmark.junit4.BenchmarkRule
+import androidx.benchmark.junit4.measureRepeated
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import io.github.readmigo.pagecurl.CurlBenchmarkHooks
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.sqrt
+
+/**
+ * Microbenchmarks for the fold geometry. Each iteration steps through a
+ * sweep of drag positions covering both directions and both corners, so a
+ * regression in any branch of the half-plane clipping shows up in the median.
+ *
+ * The geometry is internal to the library; it is reached through the
+ * restricted [CurlBenchmarkHooks] entry point.
+ */
+@RunWith(AndroidJUnit4::class)
+class CurlMathBenchmark {
+
+    @get:Rule
+    val benchmarkRule = BenchmarkRule()
+
+    private val hooks = CurlBenchmarkHooks(PAGE_W, PAGE_H)
+    private val sweep = Sweep(PAGE_W, PAGE_H)
+
+    @Test
+    fun calculateInto() {
+        var i = 0
+        benchmarkRule.measureRepeated {
+            hooks.calculateInto(sweep.touchX[i], sweep.touchY[i], sweep.cornerX[i], sweep.cornerY[i])
+            i = (i + 1) % sweep.size
+        }
+    }
+
+    @Test
+    fun calculateAllocating() {
+        var i = 0
+        benchmarkRule.measureRepeated {
+            hooks.calculate(sweep.touch(i), sweep.corner(i))
+            i = (i + 1) % sweep.size
+        }
+    }
+
+    @Test
+    fun computeInto() {
+        var i = 0
+        benchmarkRule.measureRepeated {
+            hooks.computeInto(sweep.touchX[i], sweep.touchY[i], sweep.cornerX[i], sweep.cornerY[i])
+            i = (i + 1) % sweep.size
+        }
+    }
+
+    @Test
+    fun clipHalfPlane() {
+        var i = 0
+        benchmarkRule.measureRepeated {
+            hooks.clipPage(sweep.foldX[i], sweep.foldY[i], sweep.normalX[i], sweep.normalY[i])
+            i = (i + 1) % sweep.size
+        }
+    }
+
+    /**
+     * Drag positions on a grid over (and slightly beyond) the page, paired
+     * with each of the four origin corners, plus their fold-line parameters.
+     */
+    private class Sweep(pageW: Float, pageH: Float) {
+        val size = GRID * GRID * 4
+        val touchX = FloatArray(size)
+        val touchY = FloatArray(size)
+        val cornerX = FloatArray(size)
+        val cornerY = FloatArray(size)
+        val foldX = FloatArray(size)
+        val foldY = FloatArray(size)
+        val normalX = FloatArray(size)
+        val normalY = FloatArray(size)
+
+        init {
+            var i = 0
+            for (corner in 0 until 4) {
+                // TR, BR (forward) then TL, BL (backward)
+                val cx = if (corner < 2) pageW else 0f
+                val cy = if (corner % 2 == 0) 0f else pageH
+                for (gx in 0 until GRID) {
+                    for (gy in 0 until GRID) {
+                        val tx = -0.15f * pageW + 1.3f * pageW * gx / (GRID - 1)
+                        val ty = -0.15f * pageH + 1.3f * pageH * gy / (GRID - 1)
+                        touchX[i] = tx
+                        touchY[i] = ty
+                        cornerX[i] = cx
+                        cornerY[i] = cy
+                        val dx = cx - tx
+                        val dy = cy - ty
+                        val dist = sqrt(dx * dx + dy * dy).coerceAtLeast(1f)
+                        foldX[i] = (tx + cx) / 2f
+                        foldY[i] = (ty + cy) / 2f
+                        normalX[i] = dx / dist
+                        normalY[i] = dy / dist
+                        i++
+                    }
+                }
+            }
+        }
+
+        fun touch(i: Int) = PointF(touchX[i], touchY[i])
+        fun corner(i: Int) = PointF(cornerX[i], cornerY[i])
+    }
+
+    private companion object {
+        const val PAGE_W = 1080f
+        const val PAGE_H = 2400f
+        const val GRID = 12
+    }
+}
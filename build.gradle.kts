@@ -1,5 +1,8 @@
 plugins {
+    alias(libs.plugins.android.application) apply false
     alias(libs.plugins.android.library) apply false
+    alias(libs.plugins.android.test) apply false
+    alias(libs.plugins.androidx.benchmark) apply false
     alias(libs.plugins.kotlin.android) apply false
 }
 
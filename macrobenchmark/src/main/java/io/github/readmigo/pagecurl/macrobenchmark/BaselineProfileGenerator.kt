@@ -0,0 +1,42 @@
+package io.github.readmigo.pagecurl.macrobenchmark
+
+import androidx.benchmark.macro.junit4.BaselineProfileRule
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import androidx.test.filters.LargeTest
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+
+/**
+ * Records the library's Baseline Profile from the same scripted turns the
+ * benchmarks use, once per renderer.
+ *
+ * Needs API 33+ or a rooted device. Copy the generated
+ * `BaselineProfileGenerator_generate-baseline-prof.txt` from the test
+ * output over `pagecurl/src/main/baseline-prof.txt`.
+ */
+@LargeTest
+@RunWith(AndroidJUnit4::class)
+class BaselineProfileGenerator {
+
+    @get:Rule
+    val baselineProfileRule = BaselineProfileRule()
+
+    @Test
+    fun generate() = baselineProfileRule.collect(
+        packageName = PageTurnBenchmark.TARGET_PACKAGE,
+        // The profile ships with the library, so keep only its classes
+        filterPredicate = { rule -> LIBRARY_PATH in rule && SAMPLE_PATH !in rule }
+    ) {
+        for (renderer in PageTurnBenchmark.renderers()) {
+            pressHome()
+            startActivityAndWait(PageTurnBenchmark.readerIntent(renderer))
+            turnPages()
+        }
+    }
+
+    private companion object {
+        const val LIBRARY_PATH = "io/github/readmigo/pagecurl/"
+        const val SAMPLE_PATH = "io/github/readmigo/pagecurl/sample/"
+    }
+}
@@ -0,0 +1,78 @@
+package io.github.readmigo.pagecurl.macrobenchmark
+
+import android.content.Intent
+import androidx.benchmark.macro.FrameTimingMetric
+import androidx.benchmark.macro.MacrobenchmarkScope
+import androidx.benchmark.macro.StartupMode
+import androidx.benchmark.macro.junit4.MacrobenchmarkRule
+import androidx.test.filters.LargeTest
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.junit.runners.Parameterized
+
+/**
+ * Frame timing of scripted page turns in the sample app, once per renderer.
+ *
+ * Each iteration drags two pages forward, drags one back, cancels a short
+ * drag, then taps the right and left thirds, so both gesture paths and the
+ * snap-back animation are covered.
+ */
+@LargeTest
+@RunWith(Parameterized::class)
+class PageTurnBenchmark(private val renderer: String) {
+
+    @get:Rule
+    val benchmarkRule = MacrobenchmarkRule()
+
+    @Test
+    fun pageTurns() = benchmarkRule.measureRepeated(
+        packageName = TARGET_PACKAGE,
+        metrics = listOf(FrameTimingMetric()),
+        iterations = ITERATIONS,
+        startupMode = StartupMode.WARM,
+        setupBlock = {
+            pressHome()
+            startActivityAndWait(readerIntent(renderer))
+        }
+    ) {
+        turnPages()
+    }
+
+    companion object {
+        const val TARGET_PACKAGE = "io.github.readmigo.pagecurl.sample"
+        private const val ITERATIONS = 5
+
+        @JvmStatic
+        @Parameterized.Parameters(name = "{0}")
+        fun renderers() = listOf("canvas", "mesh", "cylinder")
+
+        fun readerIntent(renderer: String) = Intent().apply {
+            setClassName(TARGET_PACKAGE, "$TARGET_PACKAGE.MainActivity")
+            putExtra("renderer", renderer)
+        }
+    }
+}
+
+/** The scripted turn sequence: drags both ways, a cancelled drag and taps. */
+internal fun MacrobenchmarkScope.turnPages() {
+    val w = device.displayWidth
+    val h = device.displayHeight
+    val steps = 40 // ~200 ms per swipe
+
+    repeat(2) {
+        device.swipe((w * 0.92f).toInt(), (h * 0.85f).toInt(), (w * 0.08f).toInt(), (h * 0.6f).toInt(), steps)
+        device.waitForIdle()
+    }
+    device.swipe((w * 0.08f).toInt(), (h * 0.15f).toInt(), (w * 0.92f).toInt(), (h * 0.4f).toInt(), steps)
+    device.waitForIdle()
+
+    // Short drag that snaps back
+    device.swipe((w * 0.92f).toInt(), (h * 0.85f).toInt(), (w * 0.8f).toInt(), (h * 0.8f).toInt(), steps)
+    device.waitForIdle()
+
+    device.click((w * 0.85f).toInt(), h / 2)
+    device.waitForIdle()
+    device.click((w * 0.15f).toInt(), h / 2)
+    device.waitForIdle()
+}
@@ -0,0 +1,46 @@
+package io.github.readmigo.pagecurl.macrobenchmark
+
+import androidx.benchmark.macro.StartupMode
+import androidx.benchmark.macro.StartupTimingMetric
+import androidx.benchmark.macro.junit4.MacrobenchmarkRule
+import androidx.test.filters.LargeTest
+import org.junit.Rule
+import org.junit.Test
+import org.junit.runner.RunWith
+import org.junit.runners.Parameterized
+
+/**
+ * Time to first frame when the sample opens straight into the reader,
+ * once per renderer and start mode.
+ *
+ * Covers the container's first-frame path: the opening page is drawn
+ * before the gesture detectors, turn engines and renderer are set up.
+ */
+@LargeTest
+@RunWith(Parameterized::class)
+class StartupBenchmark(private val startupMode: StartupMode, private val renderer: String) {
+
+    @get:Rule
+    val benchmarkRule = MacrobenchmarkRule()
+
+    @Test
+    fun openBook() = benchmarkRule.measureRepeated(
+        packageName = PageTurnBenchmark.TARGET_PACKAGE,
+        metrics = listOf(StartupTimingMetric()),
+        iterations = ITERATIONS,
+        startupMode = startupMode,
+        setupBlock = { pressHome() }
+    ) {
+        startActivityAndWait(PageTurnBenchmark.readerIntent(renderer))
+    }
+
+    companion object {
+        private const val ITERATIONS = 10
+
+        @JvmStatic
+        @Parameterized.Parameters(name = "{0}-{1}")
+        fun parameters() = listOf(StartupMode.COLD, StartupMode.WARM).flatMap { mode ->
+            PageTurnBenchmark.renderers().map { arrayOf(mode, it) }
+        }
+    }
+}
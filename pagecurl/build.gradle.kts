@@ -7,6 +7,7 @@ plugins {
 android {
     namespace = "io.github.readmigo.pagecurl"
     compileSdk = 35
+    ndkVersion = "27.0.12077973"
 
     defaultConfig {
         minSdk = 26
@@ -15,6 +16,14 @@ android {
 
     }
 
+    // Optional native geometry kernel for animated turns (see CurlNative)
+    externalNativeBuild {
+        cmake {
+            path = file("src/main/cpp/CMakeLists.txt")
+            version = "3.22.1"
+        }
+    }
+
     buildTypes {
         release {
             isMinifyEnabled = false
@@ -48,7 +57,12 @@ dependencies {
     implementation(libs.androidx.ui.graphics)
     implementation(libs.androidx.ui.tooling.preview)
     implementation(libs.androidx.material3)
+    implementation(libs.androidx.metrics.performance)
+    implementation(libs.androidx.input.motionprediction)
+    // Installs the bundled baseline-prof.txt on sideloaded and non-Play installs
+    implementation(libs.androidx.profileinstaller)
     debugImplementation(libs.androidx.ui.tooling)
+    testImplementation(libs.junit)
 }
 
 afterEvaluate {
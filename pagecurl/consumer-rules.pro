@@ -0,0 +1,4 @@
+# JNI entry points of the native geometry kernel
+-keepclasseswithmembernames class io.github.readmigo.pagecurl.CurlNative {
+    native <methods>;
+}
@@ -0,0 +1,31 @@
+// JNI bridge for CurlNative.kt.
+
+#include <jni.h>
+
+#include "curl_kernel.h"
+
+extern "C" JNIEXPORT jint JNICALL
+Java_io_github_readmigo_pagecurl_CurlNative_nativeRecordStride(JNIEnv*, jobject) {
+    return pagecurl::kRecordStride;
+}
+
+extern "C" JNIEXPORT jint JNICALL
+Java_io_github_readmigo_pagecurl_CurlNative_nativeBuildTrajectory(
+        JNIEnv* env, jobject,
+        jfloatArray out, jint frames,
+        jfloat startX, jfloat startY, jfloat endX, jfloat endY,
+        jfloat cornerX, jfloat pageW, jfloat pageH,
+        jfloat castShadowW, jfloat creaseShadowW, jfloat curlStripW) {
+    if (out == nullptr || env->GetArrayLength(out) < frames * pagecurl::kRecordStride) return 0;
+
+    const pagecurl::TrajectoryParams params{
+            startX, startY, endX, endY, cornerX, pageW, pageH,
+            castShadowW, creaseShadowW, curlStripW};
+
+    // Critical access avoids copying the ~80 KB buffer in and out
+    auto* buffer = static_cast<float*>(env->GetPrimitiveArrayCritical(out, nullptr));
+    if (buffer == nullptr) return 0;
+    const int written = pagecurl::curl_build_trajectory(params, frames, buffer);
+    env->ReleasePrimitiveArrayCritical(out, buffer, 0);
+    return written;
+}
@@ -0,0 +1,225 @@
+#include "curl_kernel.h"
+
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PAGECURL_NEON 1
+#endif
+
+namespace pagecurl {
+namespace {
+
+constexpr int kLanes = 4;
+
+// Per-frame fold parameters, four frames at a time (structure of arrays).
+struct FoldBatch {
+    float visible[kLanes];
+    float mx[kLanes], my[kLanes];
+    float nx[kLanes], ny[kLanes];
+    float half[kLanes];
+    float a[kLanes], b[kLanes], d[kLanes], tx[kLanes], ty[kLanes];
+    float cy[kLanes];
+};
+
+// Fold line, normal and reflection for frames first .. first + 3.
+// Mirrors CurlGeometry.computeInto.
+[[maybe_unused]] void fold_batch_scalar(const TrajectoryParams& p, int first, float step, FoldBatch& out) {
+    for (int lane = 0; lane < kLanes; ++lane) {
+        const float t = static_cast<float>(first + lane) * step;
+        const float ex = p.startX + (p.endX - p.startX) * t;
+        const float ey = p.startY + (p.endY - p.startY) * t;
+        const float cy = ey < p.pageH * 0.5f ? 0.0f : p.pageH;
+        const float dx = p.cornerX - ex;
+        const float dy = cy - ey;
+        const float dist = std::sqrt(dx * dx + dy * dy);
+        const float inv = dist >= 1.0f ? 1.0f / dist : 0.0f;
+        const float nx = dx * inv;
+        const float ny = dy * inv;
+        const float mx = (ex + p.cornerX) * 0.5f;
+        const float my = (ey + cy) * 0.5f;
+        // Fold direction u = (-ny, nx)
+        const float a = 2.0f * ny * ny - 1.0f;
+        const float b = -2.0f * nx * ny;
+        const float d = 2.0f * nx * nx - 1.0f;
+        out.visible[lane] = dist >= 1.0f ? 1.0f : 0.0f;
+        out.mx[lane] = mx;
+        out.my[lane] = my;
+        out.nx[lane] = nx;
+        out.ny[lane] = ny;
+        out.half[lane] = dist * 0.5f;
+        out.a[lane] = a;
+        out.b[lane] = b;
+        out.d[lane] = d;
+        out.tx[lane] = mx - a * mx - b * my;
+        out.ty[lane] = my - b * mx - d * my;
+        out.cy[lane] = cy;
+    }
+}
+
+#if PAGECURL_NEON
+inline float32x4_t sqrt_f32(float32x4_t v) {
+#if defined(__aarch64__)
+    return vsqrtq_f32(v);
+#else
+    // sqrt(v) = v * rsqrt(v), two Newton steps; v == 0 stays 0
+    float32x4_t r = vrsqrteq_f32(v);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(v, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(v, r), r));
+    const uint32x4_t zero = vceqq_f32(v, vdupq_n_f32(0.0f));
+    return vbslq_f32(zero, v, vmulq_f32(v, r));
+#endif
+}
+
+inline float32x4_t div_f32(float32x4_t n, float32x4_t d) {
+#if defined(__aarch64__)
+    return vdivq_f32(n, d);
+#else
+    float32x4_t r = vrecpeq_f32(d);
+    r = vmulq_f32(r, vrecpsq_f32(d, r));
+    r = vmulq_f32(r, vrecpsq_f32(d, r));
+    return vmulq_f32(n, r);
+#endif
+}
+
+void fold_batch_neon(const TrajectoryParams& p, int first, float step, FoldBatch& out) {
+    const float lanes[kLanes] = {0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t t = vmulq_n_f32(vaddq_f32(vld1q_f32(lanes), vdupq_n_f32(static_cast<float>(first))), step);
+    const float32x4_t ex = vmlaq_n_f32(vdupq_n_f32(p.startX), t, p.endX - p.startX);
+    const float32x4_t ey = vmlaq_n_f32(vdupq_n_f32(p.startY), t, p.endY - p.startY);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    const float32x4_t cornerX = vdupq_n_f32(p.cornerX);
+
+    const uint32x4_t top = vcltq_f32(ey, vdupq_n_f32(p.pageH * 0.5f));
+    const float32x4_t cy = vbslq_f32(top, vdupq_n_f32(0.0f), vdupq_n_f32(p.pageH));
+    const float32x4_t dx = vsubq_f32(cornerX, ex);
+    const float32x4_t dy = vsubq_f32(cy, ey);
+    const float32x4_t dist = sqrt_f32(vmlaq_f32(vmulq_f32(dx, dx), dy, dy));
+    const uint32x4_t visible = vcgeq_f32(dist, one);
+    const float32x4_t safe = vbslq_f32(visible, dist, one);
+    const float32x4_t nx = vbslq_f32(visible, div_f32(dx, safe), vdupq_n_f32(0.0f));
+    const float32x4_t ny = vbslq_f32(visible, div_f32(dy, safe), vdupq_n_f32(0.0f));
+    const float32x4_t mx = vmulq_f32(vaddq_f32(ex, cornerX), half);
+    const float32x4_t my = vmulq_f32(vaddq_f32(ey, cy), half);
+
+    const float32x4_t a = vsubq_f32(vmulq_f32(two, vmulq_f32(ny, ny)), one);
+    const float32x4_t b = vnegq_f32(vmulq_f32(two, vmulq_f32(nx, ny)));
+    const float32x4_t d = vsubq_f32(vmulq_f32(two, vmulq_f32(nx, nx)), one);
+    // tx = mx - a*mx - b*my, ty = my - b*mx - d*my
+    const float32x4_t tx = vmlsq_f32(vmlsq_f32(mx, a, mx), b, my);
+    const float32x4_t ty = vmlsq_f32(vmlsq_f32(my, b, mx), d, my);
+
+    vst1q_f32(out.visible, vbslq_f32(visible, one, vdupq_n_f32(0.0f)));
+    vst1q_f32(out.mx, mx);
+    vst1q_f32(out.my, my);
+    vst1q_f32(out.nx, nx);
+    vst1q_f32(out.ny, ny);
+    vst1q_f32(out.half, vmulq_f32(dist, half));
+    vst1q_f32(out.a, a);
+    vst1q_f32(out.b, b);
+    vst1q_f32(out.d, d);
+    vst1q_f32(out.tx, tx);
+    vst1q_f32(out.ty, ty);
+    vst1q_f32(out.cy, cy);
+}
+#endif
+
+// Clip the convex polygon src (count points) to (p - (px, py)) . (nx, ny) >= 0.
+// Same rule as CurlGeometry.clipHalfPlane.
+int clip_half_plane(const float* src, int count, float px, float py, float nx, float ny, float* dst) {
+    int out = 0;
+    for (int i = 0; i < count; ++i) {
+        const int j = (i + 1) % count;
+        const float ax = src[i * 2], ay = src[i * 2 + 1];
+        const float bx = src[j * 2], by = src[j * 2 + 1];
+        const float da = (ax - px) * nx + (ay - py) * ny;
+        const float db = (bx - px) * nx + (by - py) * ny;
+        if (da >= 0.0f) {
+            dst[out * 2] = ax;
+            dst[out * 2 + 1] = ay;
+            ++out;
+        }
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            const float t = da / (da - db);
+            dst[out * 2] = ax + (bx - ax) * t;
+            dst[out * 2 + 1] = ay + (by - ay) * t;
+            ++out;
+        }
+    }
+    return out;
+}
+
+// Writes a polygon slot: vertex count, then up to kMaxVertices points.
+void put_polygon(float* slot, const float* points, int count) {
+    if (count > kMaxVertices) count = kMaxVertices;
+    slot[0] = static_cast<float>(count);
+    for (int i = 0; i < count * 2; ++i) slot[1 + i] = points[i];
+}
+
+// Strip between the fold line and a parallel line `width` along (nx, ny),
+// as in CurlGeometry.computeInto.
+void put_strip(float* slot, const float* corners, float mx, float my, float nx, float ny, float width) {
+    float scratch[(kMaxVertices + 2) * 2];
+    float strip[(kMaxVertices + 2) * 2];
+    const int n = clip_half_plane(corners, 4, mx, my, nx, ny, scratch);
+    const int count = clip_half_plane(scratch, n, mx + nx * width, my + ny * width, -nx, -ny, strip);
+    put_polygon(slot, strip, count);
+}
+
+void write_record(const TrajectoryParams& p, const float* corners, const FoldBatch& fold, int lane, float* rec) {
+    for (int i = 0; i < kRecordStride; ++i) rec[i] = 0.0f;
+    rec[kCornerX] = p.cornerX;
+    rec[kCornerY] = fold.cy[lane];
+    if (fold.visible[lane] == 0.0f) return;
+
+    const float mx = fold.mx[lane], my = fold.my[lane];
+    const float nx = fold.nx[lane], ny = fold.ny[lane];
+
+    float poly[(kMaxVertices + 2) * 2];
+    float* slots = rec + kPolygons;
+    const int curl = clip_half_plane(corners, 4, mx, my, nx, ny, poly);
+    if (curl < 3) return;  // fold line outside the page
+    put_polygon(slots + kPolygonStride, poly, curl);
+    put_polygon(slots, poly, clip_half_plane(corners, 4, mx, my, -nx, -ny, poly));
+    put_strip(slots + 2 * kPolygonStride, corners, mx, my, nx, ny, p.castShadowW);
+    put_strip(slots + 3 * kPolygonStride, corners, mx, my, -nx, -ny, p.creaseShadowW);
+    put_strip(slots + 4 * kPolygonStride, corners, mx, my, nx, ny, p.curlStripW);
+
+    rec[kVisible] = 1.0f;
+    rec[kFoldX] = mx;
+    rec[kFoldY] = my;
+    rec[kNormalX] = nx;
+    rec[kNormalY] = ny;
+    rec[kCornerDistance] = fold.half[lane];
+    rec[kMatrix + 0] = fold.a[lane];
+    rec[kMatrix + 1] = fold.b[lane];
+    rec[kMatrix + 2] = fold.tx[lane];
+    rec[kMatrix + 3] = fold.b[lane];
+    rec[kMatrix + 4] = fold.d[lane];
+    rec[kMatrix + 5] = fold.ty[lane];
+}
+
+}  // namespace
+
+int curl_build_trajectory(const TrajectoryParams& p, int frames, float* out) {
+    if (frames < 2 || out == nullptr) return 0;
+    const float corners[8] = {0.0f, 0.0f, p.pageW, 0.0f, p.pageW, p.pageH, 0.0f, p.pageH};
+    const float step = 1.0f / static_cast<float>(frames - 1);
+
+    FoldBatch fold;
+    for (int first = 0; first < frames; first += kLanes) {
+#if PAGECURL_NEON
+        fold_batch_neon(p, first, step, fold);
+#else
+        fold_batch_scalar(p, first, step, fold);
+#endif
+        for (int lane = 0; lane < kLanes && first + lane < frames; ++lane) {
+            write_record(p, corners, fold, lane, out + (first + lane) * kRecordStride);
+        }
+    }
+    return frames;
+}
+
+}  // namespace pagecurl
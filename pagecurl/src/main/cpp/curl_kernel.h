@@ -0,0 +1,48 @@
+// Batch fold geometry for animated page turns.
+//
+// For a turn whose corner path is known in advance (start -> end, linear in
+// the animation progress t), curl_build_trajectory() computes the geometry
+// of `frames` evenly spaced values of t in one pass and writes one
+// fixed-stride record per frame. The Kotlin side (CurlTrajectory) copies a
+// record into a CurlFrame instead of recomputing it.
+//
+// The record layout must match CurlTrajectory.kt.
+
+#pragma once
+
+namespace pagecurl {
+
+// ---- Record layout (floats) ----
+constexpr int kVisible = 0;          // 1 if a curl is visible, else 0
+constexpr int kFoldX = 1;            // midpoint of touch -> corner
+constexpr int kFoldY = 2;
+constexpr int kNormalX = 3;          // unit normal toward the corner
+constexpr int kNormalY = 4;
+constexpr int kCornerDistance = 5;   // fold line to origin corner
+constexpr int kMatrix = 6;           // reflection: a, b, tx, b, d, ty
+constexpr int kCornerX = 12;         // origin corner used for this frame
+constexpr int kCornerY = 13;
+constexpr int kPolygons = 16;        // flat, curl, shadow, crease, strip
+
+constexpr int kMaxVertices = 6;
+constexpr int kPolygonStride = 1 + kMaxVertices * 2;  // count, then x, y pairs
+constexpr int kPolygonCount = 5;
+constexpr int kRecordStride = 84;    // kPolygons + 5 * 13 = 81, padded to 4
+
+static_assert(kPolygons + kPolygonCount * kPolygonStride <= kRecordStride,
+              "record overflows its stride");
+
+struct TrajectoryParams {
+    float startX, startY;   // corner position at t = 0
+    float endX, endY;       // corner position at t = 1
+    float cornerX;          // origin corner x (page edge being turned)
+    float pageW, pageH;
+    float castShadowW;      // strip widths, in pixels
+    float creaseShadowW;
+    float curlStripW;
+};
+
+// Fills out[0 .. frames * kRecordStride). Returns the number of frames written.
+int curl_build_trajectory(const TrajectoryParams& params, int frames, float* out);
+
+}  // namespace pagecurl
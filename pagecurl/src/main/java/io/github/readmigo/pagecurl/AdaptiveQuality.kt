@@ -0,0 +1,87 @@
+package io.github.readmigo.pagecurl
+
+import android.os.PowerManager
+import android.util.Log
+
+private const val TAG = "PageCurl"
+
+/** Detail levels adaptive quality gives up, in order; each implies the ones before it. */
+internal object StepDown {
+    const val NONE = 0
+    /** Skip the curl highlight layer. */
+    const val NO_HIGHLIGHT = 1
+    /** Also skip the crease shadow. */
+    const val NO_CREASE = 2
+    /** Also draw the back face from a downsampled copy (see [BackFaceCache]). */
+    const val LOW_RES_BACK = 3
+}
+
+/**
+ * Per-turn quality governor: steps layers down while a drag keeps missing
+ * frames, and back up when the turn ends.
+ *
+ * A drag redraws once per input frame, so the interval between drag draws
+ * tracks the frame rate the user sees. [OVER_BUDGET_FRAMES] consecutive
+ * intervals over 1.5 frame budgets drop one [StepDown] level for the rest of
+ * the turn; a single long interval (the finger pausing) resets nothing.
+ * The thermal status sets the level each turn starts from, so a throttled
+ * device starts degraded instead of stuttering into it.
+ */
+internal class AdaptiveQuality {
+
+    /** Latest [PowerManager] thermal status; written from the thermal listener. */
+    @Volatile
+    var thermalStatus = PowerManager.THERMAL_STATUS_NONE
+
+    /** The level drawers should apply this frame. */
+    var stepDown = StepDown.NONE
+        private set
+
+    private var frameBudgetNanos = DEFAULT_FRAME_NANOS
+    private var lastFrameNanos = -1L
+    private var overBudget = 0
+
+    /** Starts a turn at the thermal baseline. [refreshRate] is the display rate in Hz, if known. */
+    fun beginTurn(refreshRate: Float) {
+        frameBudgetNanos = if (refreshRate > 1f) (1_000_000_000L / refreshRate).toLong() else DEFAULT_FRAME_NANOS
+        lastFrameNanos = -1L
+        overBudget = 0
+        stepDown = thermalBaseline()
+    }
+
+    /** Records a frame drawn while the user is dragging, at [nowNanos]. */
+    fun onDragFrame(nowNanos: Long) {
+        val last = lastFrameNanos
+        lastFrameNanos = nowNanos
+        if (last < 0L) return
+        if ((nowNanos - last) * 2 > frameBudgetNanos * 3) {
+            if (++overBudget >= OVER_BUDGET_FRAMES && stepDown < StepDown.LOW_RES_BACK) {
+                stepDown++
+                overBudget = 0
+                Log.d(TAG, "adaptiveQuality: stepDown=$stepDown")
+            }
+        } else {
+            overBudget = 0
+        }
+    }
+
+    /** Ends the turn, restoring full detail (or the thermal baseline). */
+    fun endTurn() {
+        lastFrameNanos = -1L
+        overBudget = 0
+        stepDown = thermalBaseline()
+    }
+
+    private fun thermalBaseline(): Int = when (thermalStatus) {
+        PowerManager.THERMAL_STATUS_NONE, PowerManager.THERMAL_STATUS_LIGHT -> StepDown.NONE
+        PowerManager.THERMAL_STATUS_MODERATE -> StepDown.NO_HIGHLIGHT
+        PowerManager.THERMAL_STATUS_SEVERE -> StepDown.NO_CREASE
+        else -> StepDown.LOW_RES_BACK
+    }
+
+    companion object {
+        /** Consecutive slow drag frames before stepping down (~50 ms of jank at 60 Hz). */
+        const val OVER_BUDGET_FRAMES = 3
+        private const val DEFAULT_FRAME_NANOS = 16_666_667L
+    }
+}
@@ -0,0 +1,112 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.util.Log
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.asExecutor
+
+private const val TAG = "PageCurl"
+
+/**
+ * Downsampled copy of the page being turned, with the back-face overlay
+ * baked in, for the lower [CurlQuality] tiers.
+ *
+ * Copies are built on [Dispatchers.Default]; until one is ready [get]
+ * returns null and the drawer falls back to the full-resolution page, so
+ * the draw pass never waits. Only the latest page is kept, since only the
+ * current page is ever curled.
+ *
+ * @param scale        Downscale divisor (2 = half resolution).
+ * @param overlayColor Overlay filled over the copy (the paper-back tint).
+ */
+internal class BackFaceCache(private val scale: Int, private val overlayColor: Int) {
+
+    private class Entry(val source: Bitmap, val generationId: Int, val copy: Bitmap)
+
+    @Volatile
+    private var entry: Entry? = null
+    @Volatile
+    private var pending: Bitmap? = null
+
+    private val paint = Paint(Paint.FILTER_BITMAP_FLAG)
+
+    /** The baked copy of [source], or null (and a build is scheduled) if not ready. */
+    fun get(source: Bitmap): Bitmap? {
+        val e = entry
+        if (e != null && e.source === source && e.generationId == source.generationId) return e.copy
+        request(source)
+        return null
+    }
+
+    /** Starts building a copy of [source] in the background unless one exists or is underway. */
+    fun request(source: Bitmap) {
+        if (source.isRecycled || source.config == Bitmap.Config.HARDWARE) return
+        val e = entry
+        if (e != null && e.source === source && e.generationId == source.generationId) return
+        if (pending === source) return
+        pending = source
+        Dispatchers.Default.asExecutor().execute { build(source) }
+    }
+
+    private fun build(source: Bitmap) {
+        try {
+            val generationId = source.generationId
+            val width = (source.width / scale).coerceAtLeast(1)
+            val height = (source.height / scale).coerceAtLeast(1)
+            val copy = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888)
+            Canvas(copy).apply {
+                scale(width / source.width.toFloat(), height / source.height.toFloat())
+                drawBitmap(source, 0f, 0f, paint)
+                drawColor(overlayColor)
+            }
+            // A pooled bitmap reused mid-copy would have torn pixels
+            if (source.generationId == generationId) {
+                entry = Entry(source, generationId, copy)
+            }
+        } catch (e: RuntimeException) {
+            // Recycled concurrently or similar; the full-res path still works
+            Log.w(TAG, "back-face copy skipped: ${e.message}")
+        } catch (e: OutOfMemoryError) {
+            Log.w(TAG, "back-face copy skipped: ${e.message}")
+        } finally {
+            if (pending === source) pending = null
+        }
+    }
+
+    fun release() {
+        entry = null
+    }
+}
+
+/**
+ * A drawer's back-face copy: built ahead of time for lower [CurlQuality]
+ * tiers, and created on first use at [HIGH][CurlQuality.HIGH] once adaptive
+ * quality steps down to [StepDown.LOW_RES_BACK].
+ */
+internal class BackFaceSource(quality: CurlQuality) {
+
+    private val fixed = quality.backFaceScale > 1
+    private var cache = if (fixed) BackFaceCache(quality.backFaceScale, BACK_FACE_OVERLAY_COLOR) else null
+
+    /** The downsampled copy of [current] to draw at [stepDown], or null for full resolution. */
+    fun get(current: Bitmap, stepDown: Int): Bitmap? {
+        if (!fixed && stepDown < StepDown.LOW_RES_BACK) return null
+        val c = cache ?: BackFaceCache(ADAPTIVE_SCALE, BACK_FACE_OVERLAY_COLOR).also { cache = it }
+        return c.get(current)
+    }
+
+    /** Prewarms the copy of [current]; only tiers that always use it do so. */
+    fun prepare(current: Bitmap) {
+        if (fixed) cache?.request(current)
+    }
+
+    fun release() {
+        cache?.release()
+    }
+
+    private companion object {
+        const val ADAPTIVE_SCALE = 2
+    }
+}
@@ -0,0 +1,209 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.graphics.Path
+import android.graphics.RectF
+import android.graphics.Shader
+import android.os.Build
+import androidx.annotation.RequiresApi
+
+/**
+ * Clip-path based [CurlDrawer]: six layers, each a bitmap or gradient fill
+ * under a `save/clipPath/restore` cycle.
+ *
+ * With [cachePageLayers] (API 29+, hardware canvases) the revealed page,
+ * the front face and the tinted back face are each recorded once into a
+ * [PageLayer], so per frame only the clips and the reflection change and
+ * the page bitmaps are scaled into `dst` once per turn.
+ *
+ * Below [CurlQuality.HIGH] the back face is drawn from a [BackFaceCache]
+ * copy with the tint baked in (one layer instead of two), and the shadow
+ * layers fill their region paths directly without anti-aliasing instead of
+ * clipping a full-page rect. [StepDown] levels skip layers 6 and 4 and
+ * switch to the downsampled back face.
+ *
+ * On API 29+ the shadow and highlight layers (2, 4 and 6) are one
+ * [ShadowStrips] mesh drawn after the back face. Layers 4 and 6 keep their
+ * stacking (the crease lies outside the back face); the cast shadow lies
+ * under the opaque back face, so it is only drawn when there is none. The
+ * mesh is never anti-aliased, so it is the same at every tier; only the
+ * back face follows [CurlQuality] there.
+ */
+internal class CanvasCurlDrawer(
+    cachePageLayers: Boolean = false,
+    quality: CurlQuality = CurlQuality.HIGH
+) : CurlDrawer {
+
+    // Reusable Paint objects (avoid allocation per frame)
+    private val bitmapPaint = Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG)
+    private val backFacePaint = Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG).apply {
+        alpha = BACK_FACE_CONTENT_ALPHA
+    }
+    private val backOverlayPaint = Paint(Paint.ANTI_ALIAS_FLAG).apply {
+        color = BACK_FACE_OVERLAY_COLOR
+        style = Paint.Style.FILL
+    }
+    private val shadowPaint = Paint(Paint.ANTI_ALIAS_FLAG)
+    private val fastShadows = quality != CurlQuality.HIGH
+    private val fastShadowPaint = Paint()
+    private val backFace = BackFaceSource(quality)
+    private val strips = if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) ShadowStrips() else null
+
+    private val layers = if (cachePageLayers && Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+        CompositeLayers()
+    } else {
+        null
+    }
+
+    @RequiresApi(Build.VERSION_CODES.Q)
+    private class CompositeLayers {
+        val revealed = PageLayer()
+        val front = PageLayer()
+        val back = PageLayer(
+            contentAlpha = BACK_FACE_CONTENT_ALPHA,
+            overlayColor = BACK_FACE_OVERLAY_COLOR
+        )
+    }
+
+    override fun draw(
+        canvas: Canvas,
+        frame: CurlFrame,
+        current: Bitmap?,
+        revealed: Bitmap?,
+        dst: RectF,
+        stepDown: Int
+    ) {
+        val nc = canvas
+        val w = dst.width()
+        val h = dst.height()
+        val cached = if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q && nc.isHardwareAccelerated) {
+            layers
+        } else {
+            null
+        }
+
+        // ---- 6-layer rendering ----
+
+        // Layer 1: Revealed page (next or prev) — drawn full underneath
+        if (revealed != null) {
+            nc.save()
+            nc.clipPath(frame.backPath)
+            if (cached != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+                cached.revealed.draw(nc, revealed, dst)
+            } else {
+                nc.drawBitmap(revealed, null, dst, bitmapPaint)
+            }
+            nc.restore()
+        }
+
+        // Layer 2: Cast shadow on revealed page (along fold line, curl side)
+        if (strips == null && !frame.shadowRegionPath.isEmpty) {
+            drawShadow(nc, frame.shadowRegionPath, frame.castShadowGradient, w, h)
+        }
+
+        // Layer 3: Flat part of current page (front face, uncurled)
+        current?.let { bmp ->
+            nc.save()
+            nc.clipPath(frame.flatPath)
+            if (cached != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+                cached.front.draw(nc, bmp, dst)
+            } else {
+                nc.drawBitmap(bmp, null, dst, bitmapPaint)
+            }
+            nc.restore()
+        }
+
+        // Layer 4: Crease shadow on flat page (along fold line, flat side)
+        if (strips == null && stepDown < StepDown.NO_CREASE && !frame.creaseRegionPath.isEmpty) {
+            drawShadow(nc, frame.creaseRegionPath, frame.creaseShadowGradient, w, h)
+        }
+
+        // Layer 5: Back face of curled page (full curl region — flat paper being turned)
+        if (!frame.backPath.isEmpty) {
+            current?.let { bmp ->
+                val lowRes = backFace.get(bmp, stepDown)
+                if (lowRes != null) {
+                    // Downsampled copy with the tint baked in
+                    nc.save()
+                    nc.clipPath(frame.backPath)
+                    nc.concat(frame.backMatrix)
+                    nc.drawBitmap(lowRes, null, dst, backFacePaint)
+                    nc.restore()
+                    return@let
+                }
+                if (cached != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+                    // Tint is baked into the back layer: one reflected composite
+                    nc.save()
+                    nc.clipPath(frame.backPath)
+                    nc.concat(frame.backMatrix)
+                    cached.back.draw(nc, bmp, dst)
+                    nc.restore()
+                    return@let
+                }
+                nc.save()
+                nc.clipPath(frame.backPath)
+                nc.concat(frame.backMatrix)
+                nc.drawBitmap(bmp, null, dst, backFacePaint)
+                nc.restore()
+
+                // Paper-back white overlay for realistic look
+                nc.save()
+                nc.clipPath(frame.backPath)
+                nc.drawRect(0f, 0f, w, h, backOverlayPaint)
+                nc.restore()
+            }
+
+            // Layer 6: Curl cylinder highlight gradient (3D illusion)
+            if (strips == null && stepDown < StepDown.NO_HIGHLIGHT && !frame.curlStripPath.isEmpty) {
+                drawShadow(nc, frame.curlStripPath, frame.curlHighlightGradient, w, h)
+            }
+        }
+
+        // Layers 2, 4 and 6 in one mesh
+        strips?.draw(
+            nc, frame,
+            cast = current == null || frame.backPath.isEmpty,
+            crease = stepDown < StepDown.NO_CREASE,
+            highlight = !frame.backPath.isEmpty && stepDown < StepDown.NO_HIGHLIGHT
+        )
+    }
+
+    /** Fills [region] with [gradient]: clipped rect when anti-aliased, plain path fill otherwise. */
+    private fun drawShadow(canvas: Canvas, region: Path, gradient: Shader?, w: Float, h: Float) {
+        if (fastShadows) {
+            fastShadowPaint.shader = gradient
+            canvas.drawPath(region, fastShadowPaint)
+            fastShadowPaint.shader = null
+            return
+        }
+        shadowPaint.shader = gradient
+        canvas.save()
+        canvas.clipPath(region)
+        canvas.drawRect(0f, 0f, w, h, shadowPaint)
+        canvas.restore()
+        shadowPaint.shader = null
+    }
+
+    override fun prepare(current: Bitmap) {
+        backFace.prepare(current)
+    }
+
+    override fun holds(bitmap: Bitmap): Boolean {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return false
+        val l = layers ?: return false
+        return l.revealed.holds(bitmap) || l.front.holds(bitmap) || l.back.holds(bitmap)
+    }
+
+    override fun release() {
+        backFace.release()
+        if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+            layers?.run {
+                revealed.release()
+                front.release()
+                back.release()
+            }
+        }
+    }
+}
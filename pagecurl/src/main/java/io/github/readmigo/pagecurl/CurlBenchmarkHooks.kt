@@ -0,0 +1,48 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.PointF
+import androidx.annotation.RestrictTo
+
+/**
+ * Entry points into the internal fold geometry for the `:benchmark`
+ * module, which cannot see `internal` declarations. Not part of the API.
+ *
+ * Each call works on buffers owned by the instance, sized for a
+ * [pageW] x [pageH] page with the renderers' band widths, and returns a
+ * result so the measured work cannot be optimised away.
+ */
+@RestrictTo(RestrictTo.Scope.LIBRARY_GROUP)
+class CurlBenchmarkHooks(private val pageW: Float, private val pageH: Float) {
+
+    private val frame = CurlFrame()
+    private val record = FloatArray(CurlGeometry.RECORD_STRIDE)
+    private val scratch = FloatArray(CurlGeometry.SCRATCH_SIZE)
+    private val page = floatArrayOf(0f, 0f, pageW, 0f, pageW, pageH, 0f, pageH)
+    private val clipped = FloatArray(CurlGeometry.MAX_POLYGON_VERTICES * 2)
+
+    /** [CurlMath.calculateInto] into a reused frame. @return whether a curl is visible. */
+    fun calculateInto(touchX: Float, touchY: Float, cornerX: Float, cornerY: Float): Boolean {
+        CurlMath.calculateInto(frame, touchX, touchY, cornerX, cornerY, pageW, pageH)
+        return frame.isVisible
+    }
+
+    /** [CurlMath.calculate], allocating a new frame. @return whether a curl is visible. */
+    fun calculate(touch: PointF, corner: PointF): Boolean =
+        CurlMath.calculate(touch, corner, pageW, pageH).isVisible
+
+    /** One [CurlGeometry.computeInto] record. @return whether a curl is visible. */
+    fun computeInto(touchX: Float, touchY: Float, cornerX: Float, cornerY: Float): Boolean =
+        CurlGeometry.computeInto(
+            record, 0,
+            touchX, touchY, cornerX, cornerY,
+            pageW, pageH,
+            pageW * CurlMath.CAST_SHADOW_FRACTION,
+            pageW * CurlMath.CREASE_SHADOW_FRACTION,
+            pageW * CurlMath.CURL_STRIP_FRACTION,
+            scratch
+        )
+
+    /** The page clipped to one side of a fold line. @return the vertex count. */
+    fun clipPage(foldX: Float, foldY: Float, normalX: Float, normalY: Float): Int =
+        CurlGeometry.clipHalfPlane(page, 4, foldX, foldY, normalX, normalY, clipped)
+}
@@ -0,0 +1,77 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.RectF
+import android.os.Build
+
+// Back-face rendering: opacity of the mirrored page content (0-255)
+internal const val BACK_FACE_CONTENT_ALPHA = 255
+// Back-face rendering: semi-transparent white overlay for paper-back look
+internal const val BACK_FACE_OVERLAY_ALPHA = 90
+internal val BACK_FACE_OVERLAY_COLOR = android.graphics.Color.argb(BACK_FACE_OVERLAY_ALPHA, 255, 255, 255)
+
+/**
+ * Draws the page layers for one visible [CurlFrame].
+ *
+ * Implementations own their Paints and scratch buffers and must not
+ * allocate per call once warmed up.
+ */
+internal interface CurlDrawer {
+
+    /**
+     * @param canvas   Target canvas, already cleared to the background color.
+     * @param frame    Geometry for this frame; [CurlFrame.isVisible] is true.
+     * @param current  The page being turned.
+     * @param revealed The page underneath (next or previous), if any.
+     * @param dst      Destination rectangle the page bitmaps are scaled into.
+     * @param stepDown Layers to give up for frame rate; see [StepDown].
+     */
+    fun draw(
+        canvas: Canvas,
+        frame: CurlFrame,
+        current: Bitmap?,
+        revealed: Bitmap?,
+        dst: RectF,
+        stepDown: Int = StepDown.NONE
+    )
+
+    /** Called when [current] becomes the page that may be turned next, to warm caches. */
+    fun prepare(current: Bitmap) {}
+
+    /** Frees cached layers or textures; the drawer may be reused afterwards. */
+    fun release() {}
+
+    /** Whether a cached layer or shader still references [bitmap]. */
+    fun holds(bitmap: Bitmap): Boolean = false
+}
+
+/**
+ * Creates the drawer for [renderer], falling back to Canvas where unsupported.
+ *
+ * @param density Display density, used to size cylinder tessellation.
+ * @param cachePageLayers Record page composites into offscreen layers
+ *                        (Canvas renderer only; see [CanvasCurlDrawer]).
+ * @param quality Resolved quality tier (not [CurlQuality.AUTO]); the
+ *                cylinder renderer shades its own back face and ignores it,
+ *                as it does [StepDown] levels.
+ */
+internal fun createCurlDrawer(
+    renderer: CurlRenderer,
+    density: Float,
+    cachePageLayers: Boolean = false,
+    quality: CurlQuality = CurlQuality.HIGH
+): CurlDrawer {
+    val meshSupported = Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q
+    val canvasDrawer = { CanvasCurlDrawer(cachePageLayers, quality) }
+    return when (renderer) {
+        CurlRenderer.Canvas -> canvasDrawer()
+        CurlRenderer.Mesh -> if (meshSupported) MeshCurlDrawer(quality) else canvasDrawer()
+        is CurlRenderer.Cylinder ->
+            if (meshSupported) {
+                CylinderCurlDrawer(renderer.radiusFraction, density)
+            } else {
+                canvasDrawer()
+            }
+    }
+}
@@ -0,0 +1,189 @@
+package io.github.readmigo.pagecurl
+
+import kotlin.math.sqrt
+
+/**
+ * The fold geometry of one curl frame as plain float arithmetic, with no
+ * `android.graphics` types, so it runs unchanged on a host JVM.
+ *
+ * [computeInto] writes one record in the native kernel's layout: the same
+ * fields `curl_kernel.cpp` writes for a frame, computed the same way. Every
+ * region is the page rectangle clipped by half-planes parallel to the fold
+ * line ([clipHalfPlane]), so there is no parallel-edge cutoff and no
+ * clamped intersection parameter; crossing points are interpolated from
+ * signed distances. A frame is flat only when the touch point is within
+ * [MIN_CURL_DISTANCE] of the corner or the fold line misses the page.
+ *
+ * Records are read back by [CurlMath.loadRecord] into paths, matrices and
+ * shaders, and tabulated by [CurlTrajectory]. Nothing here allocates.
+ */
+internal object CurlGeometry {
+
+    // ---- Record layout (floats), mirrors curl_kernel.h ----
+    const val VISIBLE = 0
+    const val FOLD_X = 1
+    const val FOLD_Y = 2
+    const val NORMAL_X = 3
+    const val NORMAL_Y = 4
+    const val CORNER_DISTANCE = 5
+    const val MATRIX = 6
+    const val CORNER_X = 12
+    const val CORNER_Y = 13
+    const val POLYGONS = 16
+    /** A rectangle clipped by two parallel lines yields at most 6 vertices. */
+    const val MAX_POLYGON_VERTICES = 6
+    const val POLYGON_STRIDE = 1 + MAX_POLYGON_VERTICES * 2
+    const val RECORD_STRIDE = 84
+
+    // ---- Polygon slots, in record order ----
+    const val FLAT = 0
+    const val CURL = 1
+    const val CAST_SHADOW = 2
+    const val CREASE = 3
+    const val CURL_STRIP = 4
+
+    /** Shortest touch-to-corner distance, in pixels, that shows a curl. */
+    const val MIN_CURL_DISTANCE = 1f
+
+    /** Floats of scratch space [computeInto] needs. */
+    const val SCRATCH_SIZE = 8 + 2 * MAX_POLYGON_VERTICES * 2
+
+    private const val SCRATCH_A = 8
+    private const val SCRATCH_B = SCRATCH_A + MAX_POLYGON_VERTICES * 2
+
+    /** Offset in a record at [offset] of polygon [slot] (its vertex count, then x, y pairs). */
+    fun polygonOffset(offset: Int, slot: Int): Int = offset + POLYGONS + slot * POLYGON_STRIDE
+
+    /**
+     * Computes the frame for the corner ([cornerX], [cornerY]) dragged to
+     * ([touchX], [touchY]) on a [pageW] x [pageH] page into [out] at
+     * [offset]. The band widths are in pixels.
+     *
+     * @return whether a curl is visible; a flat frame is all zeros apart
+     *         from its corner.
+     */
+    fun computeInto(
+        out: FloatArray, offset: Int,
+        touchX: Float, touchY: Float,
+        cornerX: Float, cornerY: Float,
+        pageW: Float, pageH: Float,
+        castShadowW: Float, creaseShadowW: Float, curlStripW: Float,
+        scratch: FloatArray
+    ): Boolean {
+        out.fill(0f, offset, offset + RECORD_STRIDE)
+        out[offset + CORNER_X] = cornerX
+        out[offset + CORNER_Y] = cornerY
+
+        // Vector from touch to corner
+        val dx = cornerX - touchX
+        val dy = cornerY - touchY
+        val dist = sqrt(dx * dx + dy * dy)
+        if (!(dist >= MIN_CURL_DISTANCE)) return false
+
+        // Fold line: through the midpoint, normal toward the corner (curl side)
+        val mx = (touchX + cornerX) / 2f
+        val my = (touchY + cornerY) / 2f
+        val nx = dx / dist
+        val ny = dy / dist
+
+        scratch[0] = 0f; scratch[1] = 0f       // TL
+        scratch[2] = pageW; scratch[3] = 0f    // TR
+        scratch[4] = pageW; scratch[5] = pageH // BR
+        scratch[6] = 0f; scratch[7] = pageH    // BL
+
+        val curl = clipHalfPlane(scratch, 0, 4, mx, my, nx, ny, scratch, SCRATCH_A)
+        if (curl < 3) return false // fold line outside the page
+        putPolygon(out, polygonOffset(offset, CURL), scratch, SCRATCH_A, curl)
+        val flat = clipHalfPlane(scratch, 0, 4, mx, my, -nx, -ny, scratch, SCRATCH_A)
+        putPolygon(out, polygonOffset(offset, FLAT), scratch, SCRATCH_A, flat)
+        putStrip(out, polygonOffset(offset, CAST_SHADOW), scratch, mx, my, nx, ny, castShadowW)
+        putStrip(out, polygonOffset(offset, CREASE), scratch, mx, my, -nx, -ny, creaseShadowW)
+        putStrip(out, polygonOffset(offset, CURL_STRIP), scratch, mx, my, nx, ny, curlStripW)
+
+        // Reflection across the fold line, direction u = (-ny, nx):
+        //   | 2*ux²-1  2*ux*uy  tx |
+        //   | 2*ux*uy  2*uy²-1  ty |
+        val a = 2f * ny * ny - 1f
+        val b = -2f * nx * ny
+        val d = 2f * nx * nx - 1f
+        out[offset + VISIBLE] = 1f
+        out[offset + FOLD_X] = mx
+        out[offset + FOLD_Y] = my
+        out[offset + NORMAL_X] = nx
+        out[offset + NORMAL_Y] = ny
+        out[offset + CORNER_DISTANCE] = dist / 2f
+        out[offset + MATRIX] = a
+        out[offset + MATRIX + 1] = b
+        out[offset + MATRIX + 2] = mx - a * mx - b * my
+        out[offset + MATRIX + 3] = b
+        out[offset + MATRIX + 4] = d
+        out[offset + MATRIX + 5] = my - b * mx - d * my
+        return true
+    }
+
+    /**
+     * Clip the convex polygon [src] (first [count] points) to the half-plane
+     * (p - (px, py)) · (nx, ny) >= 0, writing the result to [dst].
+     *
+     * Crossing points are interpolated from the signed distances of the edge
+     * endpoints, so there is no parallel-line special case.
+     *
+     * @return the number of points written.
+     */
+    fun clipHalfPlane(
+        src: FloatArray, count: Int,
+        px: Float, py: Float,
+        nx: Float, ny: Float,
+        dst: FloatArray
+    ): Int = clipHalfPlane(src, 0, count, px, py, nx, ny, dst, 0)
+
+    /** [clipHalfPlane] reading [src] from [srcOffset] and writing [dst] from [dstOffset]. */
+    fun clipHalfPlane(
+        src: FloatArray, srcOffset: Int, count: Int,
+        px: Float, py: Float,
+        nx: Float, ny: Float,
+        dst: FloatArray, dstOffset: Int
+    ): Int {
+        var outCount = 0
+        for (i in 0 until count) {
+            val ax = src[srcOffset + i * 2]
+            val ay = src[srcOffset + i * 2 + 1]
+            val j = (i + 1) % count
+            val bx = src[srcOffset + j * 2]
+            val by = src[srcOffset + j * 2 + 1]
+            val da = (ax - px) * nx + (ay - py) * ny
+            val db = (bx - px) * nx + (by - py) * ny
+
+            if (da >= 0f) {
+                dst[dstOffset + outCount * 2] = ax
+                dst[dstOffset + outCount * 2 + 1] = ay
+                outCount++
+            }
+            if ((da >= 0f) != (db >= 0f)) {
+                val t = da / (da - db)
+                dst[dstOffset + outCount * 2] = ax + (bx - ax) * t
+                dst[dstOffset + outCount * 2 + 1] = ay + (by - ay) * t
+                outCount++
+            }
+        }
+        return outCount
+    }
+
+    // Strip between the fold line and a parallel line `width` along (nx, ny)
+    private fun putStrip(
+        out: FloatArray, slot: Int, scratch: FloatArray,
+        mx: Float, my: Float, nx: Float, ny: Float, width: Float
+    ) {
+        val n = clipHalfPlane(scratch, 0, 4, mx, my, nx, ny, scratch, SCRATCH_A)
+        val count = clipHalfPlane(
+            scratch, SCRATCH_A, n, mx + nx * width, my + ny * width, -nx, -ny, scratch, SCRATCH_B
+        )
+        putPolygon(out, slot, scratch, SCRATCH_B, count)
+    }
+
+    private fun putPolygon(out: FloatArray, slot: Int, points: FloatArray, from: Int, count: Int) {
+        val n = count.coerceAtMost(MAX_POLYGON_VERTICES)
+        out[slot] = n.toFloat()
+        points.copyInto(out, slot + 1, from, from + n * 2)
+    }
+}
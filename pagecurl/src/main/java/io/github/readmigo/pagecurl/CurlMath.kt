@@ -4,42 +4,153 @@ import android.graphics.LinearGradient
 import android.graphics.Matrix
 import android.graphics.Path
 import android.graphics.PointF
+import android.graphics.RectF
 import android.graphics.Shader
-import kotlin.math.abs
-import kotlin.math.max
-import kotlin.math.sqrt
+import kotlin.math.PI
+import kotlin.math.acos
+import kotlin.math.ceil
+import kotlin.math.floor
+import kotlin.math.min
+import kotlin.math.roundToInt
+import kotlin.math.sin
 
 /**
  * Computed geometry for a single frame of page curl animation.
  *
  * Describes the fold line, clipping regions, reflection matrix, and
  * shadow gradients needed to render the curl on a Canvas.
+ *
+ * A frame is mutable and meant to be reused: [CurlMath.calculateInto]
+ * resets and refills the same paths, matrix, shaders and vertex buffers
+ * every draw, so a steady-state drag allocates nothing.
  */
-internal class CurlFrame(
+internal class CurlFrame {
     /** Clip path for the flat (uncurled) region of the current page. */
-    val flatPath: Path,
+    val flatPath = Path()
     /** Clip path for the back-face (reflected curl) region. */
-    val backPath: Path,
+    val backPath = Path()
     /** Matrix that reflects content across the fold line (for back face). */
-    val backMatrix: Matrix,
+    val backMatrix = Matrix()
     /** Shadow gradient cast by the curled page onto the revealed page. */
-    val castShadowGradient: LinearGradient?,
+    val castShadowGradient = LinearGradient(
+        0f, 0f, 1f, 0f,
+        intArrayOf(
+            android.graphics.Color.argb(CurlMath.CAST_SHADOW_ALPHA, 0, 0, 0),
+            android.graphics.Color.argb(0, 0, 0, 0)
+        ),
+        null,
+        Shader.TileMode.CLAMP
+    )
     /** Shadow gradient at the fold crease on the flat page. */
-    val creaseShadowGradient: LinearGradient?,
+    val creaseShadowGradient = LinearGradient(
+        0f, 0f, 1f, 0f,
+        intArrayOf(
+            android.graphics.Color.argb(CurlMath.CREASE_SHADOW_ALPHA, 0, 0, 0),
+            android.graphics.Color.argb(0, 0, 0, 0)
+        ),
+        null,
+        Shader.TileMode.CLAMP
+    )
     /** Region where the cast shadow is drawn (strip on curl side of fold). */
-    val shadowRegionPath: Path,
+    val shadowRegionPath = Path()
     /** Region where the crease shadow is drawn (strip on flat side of fold). */
-    val creaseRegionPath: Path,
+    val creaseRegionPath = Path()
     /** Narrow strip along the fold line representing the visible curl cylinder. */
-    val curlStripPath: Path,
+    val curlStripPath = Path()
     /** Gradient overlay on the curl strip for 3D cylinder illusion. */
-    val curlHighlightGradient: LinearGradient?,
+    val curlHighlightGradient = LinearGradient(
+        0f, 0f, 1f, 0f,
+        intArrayOf(
+            android.graphics.Color.argb(60, 255, 255, 255),  // bright at fold edge
+            android.graphics.Color.argb(0, 128, 128, 128),   // neutral center
+            android.graphics.Color.argb(80, 0, 0, 0)         // shadow at outer edge
+        ),
+        floatArrayOf(0f, 0.35f, 1f),
+        Shader.TileMode.CLAMP
+    )
+    /**
+     * Rectangle, in page coordinates and whole pixels, holding every pixel
+     * that differs from the page lying flat: the curl region and the shadow
+     * strips. Empty when no curl is visible.
+     */
+    val dirtyBounds = RectF()
     /** Whether a curl is actually visible (false = page is fully flat). */
-    val isVisible: Boolean
-)
+    var isVisible = false
+        internal set
+    /**
+     * Bumped every time the geometry is recomputed. Drawers compare it with
+     * the value they last built from to skip rebuilding unchanged meshes.
+     */
+    var generation = 0
+        internal set
+
+    // ---- Fold line (valid when isVisible) ----
+    /** Midpoint of the touch-to-corner segment, a point on the fold line. */
+    var foldX = 0f
+        internal set
+    var foldY = 0f
+        internal set
+    /** Unit normal from the fold line toward the corner (curl side). */
+    var normalX = 0f
+        internal set
+    var normalY = 0f
+        internal set
+    /** Distance from the fold line to the origin corner (half the touch-to-corner distance). */
+    var cornerDistance = 0f
+        internal set
+    /** Widths of the cast shadow, crease shadow and curl strip bands, in pixels. */
+    var castShadowWidth = 0f
+        internal set
+    var creaseShadowWidth = 0f
+        internal set
+    var curlStripWidth = 0f
+        internal set
+
+    // ---- Region polygons as flat (x, y) vertex buffers ----
+    /** Vertices of the flat region polygon; [flatVertexCount] points are valid. */
+    val flatVerts = FloatArray(MAX_POLYGON_VERTICES * 2)
+    var flatVertexCount = 0
+        internal set
+    /** Vertices of the curl (back-face) region polygon; [curlVertexCount] points are valid. */
+    val curlVerts = FloatArray(MAX_POLYGON_VERTICES * 2)
+    var curlVertexCount = 0
+        internal set
+    /** Vertices of the cast shadow strip ([shadowRegionPath]). */
+    val shadowVerts = FloatArray(MAX_POLYGON_VERTICES * 2)
+    var shadowVertexCount = 0
+        internal set
+    /** Vertices of the crease shadow strip ([creaseRegionPath]). */
+    val creaseVerts = FloatArray(MAX_POLYGON_VERTICES * 2)
+    var creaseVertexCount = 0
+        internal set
+    /** Vertices of the curl cylinder strip ([curlStripPath]). */
+    val curlStripVerts = FloatArray(MAX_POLYGON_VERTICES * 2)
+    var curlStripVertexCount = 0
+        internal set
+
+    // Quantized inputs of the last CurlMath.updateInto (NO_INPUT = none yet)
+    internal var inputTouchX = NO_INPUT
+    internal var inputTouchY = NO_INPUT
+    internal var inputCornerX = NO_INPUT
+    internal var inputCornerY = NO_INPUT
+    internal var inputPageW = 0f
+    internal var inputPageH = 0f
+
+    // Scratch storage reused by CurlMath
+    internal val pageCorners = FloatArray(8)
+    internal val record = FloatArray(CurlGeometry.RECORD_STRIDE)
+    internal val geometryScratch = FloatArray(CurlGeometry.SCRATCH_SIZE)
+    internal val matrixValues = FloatArray(9)
+    internal val shaderMatrix = Matrix()
+
+    internal companion object {
+        const val MAX_POLYGON_VERTICES = CurlGeometry.MAX_POLYGON_VERTICES
+        const val NO_INPUT = Int.MIN_VALUE
+    }
+}
 
 /**
- * Pure-math geometry calculator for the bezier page curl effect.
+ * Geometry calculator for the bezier page curl effect.
  *
  * Given the dragged corner position (touch) and the original corner position,
  * computes fold line, clipping regions, reflection matrix, and shadow parameters.
@@ -47,18 +158,35 @@ internal class CurlFrame(
  * The fold line is the perpendicular bisector of the segment from touch to corner.
  * Everything on the corner's side of this line is the "curl region" (back face).
  * Everything on the other side is the "flat region" (front face, still lying flat).
+ *
+ * The arithmetic lives in [CurlGeometry], which fills a plain float record;
+ * this object turns records into a [CurlFrame]'s paths, matrix and shaders.
  */
 internal object CurlMath {
 
-    private const val CAST_SHADOW_FRACTION = 0.15f   // shadow width as fraction of page width
-    private const val CREASE_SHADOW_FRACTION = 0.06f  // crease width as fraction of page width
-    private const val CAST_SHADOW_ALPHA = 80          // max shadow opacity (0-255)
-    private const val CREASE_SHADOW_ALPHA = 50        // max crease opacity (0-255)
-    private const val CURL_STRIP_FRACTION = 0.08f     // curl cylinder width as fraction of page width
+    internal const val CAST_SHADOW_FRACTION = 0.15f   // shadow width as fraction of page width
+    internal const val CREASE_SHADOW_FRACTION = 0.06f  // crease width as fraction of page width
+    internal const val CAST_SHADOW_ALPHA = 80         // max shadow opacity (0-255)
+    internal const val CREASE_SHADOW_ALPHA = 50       // max crease opacity (0-255)
+    internal const val CURL_STRIP_FRACTION = 0.08f     // curl cylinder width as fraction of page width
+
+    private const val INPUT_STEPS_PER_PX = 4f         // updateInto ignores moves under a quarter pixel
+
+    private const val CHORD_TOLERANCE_PX = 0.5f       // max gap between cylinder arc and its chords
+    private const val MIN_CYLINDER_SEGMENTS = 4
+    private const val MAX_CYLINDER_SEGMENTS = 48
+    private const val SEGMENTS_PER_DENSITY = 12f      // segment cap per unit of display density
+    private const val CYLINDER_FRONT_DARKEN = 0.35f   // darkening at the cylinder's steepest front point
+    private const val CYLINDER_BACK_DARKEN = 0.15f    // darkening on the underside as it rolls over
+    private const val OPAQUE_WHITE = -0x1             // leaves modulated texture unchanged
+    private val BACK_OVERLAY_COLOR = android.graphics.Color.argb(BACK_FACE_OVERLAY_ALPHA, 255, 255, 255)
 
     /**
      * Calculate the complete curl geometry for one frame.
      *
+     * Allocates a fresh [CurlFrame]; per-frame callers should hold a frame
+     * and use [calculateInto] instead.
+     *
      * @param touch   Where the page corner has been dragged to (in page coordinates).
      * @param corner  Original position of the page corner (e.g. pageW, pageH).
      * @param pageW   Page width in pixels.
@@ -70,296 +198,392 @@ internal object CurlMath {
         corner: PointF,
         pageW: Float,
         pageH: Float
-    ): CurlFrame {
-        // Vector from touch to corner
-        val dx = corner.x - touch.x
-        val dy = corner.y - touch.y
-        val dist = sqrt(dx * dx + dy * dy)
-
-        if (dist < 1f) {
-            return noCurl(pageW, pageH)
-        }
+    ): CurlFrame = CurlFrame().also { calculateInto(it, touch, corner, pageW, pageH) }
 
-        // Midpoint of touch-to-corner segment (point on the fold line)
-        val mx = (touch.x + corner.x) / 2f
-        val my = (touch.y + corner.y) / 2f
-
-        // Unit normal from fold line toward corner (curl side)
-        val nx = dx / dist
-        val ny = dy / dist
-
-        // Fold line direction (perpendicular to normal)
-        val fldx = -ny
-        val fldy = nx
-
-        // Extend fold line far beyond page for intersection calculations
-        val ext = (pageW + pageH) * 2f
-        val foldP1 = PointF(mx - fldx * ext, my - fldy * ext)
-        val foldP2 = PointF(mx + fldx * ext, my + fldy * ext)
+    /**
+     * Calculate the curl geometry for one frame into an existing [frame],
+     * reusing its paths, matrix, shaders and vertex buffers.
+     */
+    fun calculateInto(
+        frame: CurlFrame,
+        touch: PointF,
+        corner: PointF,
+        pageW: Float,
+        pageH: Float
+    ) = calculateInto(frame, touch.x, touch.y, corner.x, corner.y, pageW, pageH)
 
-        // Classify point: flat side (toward touch) vs curl side (toward corner)
-        fun isFlat(px: Float, py: Float): Boolean {
-            return (px - mx) * nx + (py - my) * ny <= 0
+    /**
+     * Memoized [calculateInto]: recomputes [frame] only when the touch point
+     * or origin corner moves by at least a quarter pixel, or the page size
+     * changes, so idle and settling redraws reuse the previous geometry.
+     *
+     * @return true if the frame was recomputed.
+     */
+    fun updateInto(
+        frame: CurlFrame,
+        touchX: Float,
+        touchY: Float,
+        cornerX: Float,
+        cornerY: Float,
+        pageW: Float,
+        pageH: Float
+    ): Boolean {
+        val qtx = (touchX * INPUT_STEPS_PER_PX).roundToInt()
+        val qty = (touchY * INPUT_STEPS_PER_PX).roundToInt()
+        val qcx = (cornerX * INPUT_STEPS_PER_PX).roundToInt()
+        val qcy = (cornerY * INPUT_STEPS_PER_PX).roundToInt()
+        if (qtx == frame.inputTouchX && qty == frame.inputTouchY &&
+            qcx == frame.inputCornerX && qcy == frame.inputCornerY &&
+            pageW == frame.inputPageW && pageH == frame.inputPageH
+        ) {
+            return false
         }
+        frame.inputTouchX = qtx
+        frame.inputTouchY = qty
+        frame.inputCornerX = qcx
+        frame.inputCornerY = qcy
+        frame.inputPageW = pageW
+        frame.inputPageH = pageH
+        calculateInto(frame, touchX, touchY, cornerX, cornerY, pageW, pageH)
+        return true
+    }
 
-        // Build the two region polygons
-        val (flatPath, curlPath) = buildRegionPaths(
-            foldP1, foldP2, pageW, pageH, ::isFlat
+    /** Primitive-coordinate variant of [calculateInto]. */
+    fun calculateInto(
+        frame: CurlFrame,
+        touchX: Float,
+        touchY: Float,
+        cornerX: Float,
+        cornerY: Float,
+        pageW: Float,
+        pageH: Float
+    ) {
+        frame.generation++
+        CurlGeometry.computeInto(
+            frame.record, 0,
+            touchX, touchY, cornerX, cornerY, pageW, pageH,
+            pageW * CAST_SHADOW_FRACTION,
+            pageW * CREASE_SHADOW_FRACTION,
+            pageW * CURL_STRIP_FRACTION,
+            frame.geometryScratch
         )
+        applyRecord(frame, frame.record, 0, pageW, pageH)
+    }
+
+    /**
+     * Fill [frame] from a precomputed record (see [CurlTrajectory])
+     * starting at [offset] in [records]. Only paths and
+     * shader matrices are built here; all fold math comes from the record.
+     */
+    fun loadRecord(
+        frame: CurlFrame,
+        records: FloatArray,
+        offset: Int,
+        pageW: Float,
+        pageH: Float
+    ) {
+        frame.generation++
+        // The updateInto memo no longer describes this frame
+        frame.inputTouchX = CurlFrame.NO_INPUT
+        applyRecord(frame, records, offset, pageW, pageH)
+    }
 
-        if (curlPath.isEmpty) {
-            return noCurl(pageW, pageH)
+    /** Builds [frame]'s paths, matrix and shader placement from a record. */
+    private fun applyRecord(
+        frame: CurlFrame,
+        records: FloatArray,
+        offset: Int,
+        pageW: Float,
+        pageH: Float
+    ) {
+        val corners = frame.pageCorners
+        corners[0] = 0f; corners[1] = 0f       // TL
+        corners[2] = pageW; corners[3] = 0f    // TR
+        corners[4] = pageW; corners[5] = pageH // BR
+        corners[6] = 0f; corners[7] = pageH    // BL
+
+        if (records[offset + CurlGeometry.VISIBLE] == 0f) {
+            noCurl(frame, pageW, pageH)
+            return
         }
 
-        // Reflection matrix across fold line (for drawing the back face)
-        val backMatrix = buildReflectionMatrix(mx, my, fldx, fldy)
+        val mx = records[offset + CurlGeometry.FOLD_X]
+        val my = records[offset + CurlGeometry.FOLD_Y]
+        val nx = records[offset + CurlGeometry.NORMAL_X]
+        val ny = records[offset + CurlGeometry.NORMAL_Y]
+        frame.foldX = mx
+        frame.foldY = my
+        frame.normalX = nx
+        frame.normalY = ny
+        frame.cornerDistance = records[offset + CurlGeometry.CORNER_DISTANCE]
+
+        val v = frame.matrixValues
+        records.copyInto(v, 0, offset + CurlGeometry.MATRIX, offset + CurlGeometry.MATRIX + 6)
+        v[6] = 0f; v[7] = 0f; v[8] = 1f
+        frame.backMatrix.setValues(v)
 
-        // Shadow parameters scale with page size
         val castShadowW = pageW * CAST_SHADOW_FRACTION
         val creaseShadowW = pageW * CREASE_SHADOW_FRACTION
-
-        // Cast shadow: dark at fold line, fading toward curl side
-        val castShadowGradient = LinearGradient(
-            mx, my,
-            mx + nx * castShadowW, my + ny * castShadowW,
-            intArrayOf(
-                android.graphics.Color.argb(CAST_SHADOW_ALPHA, 0, 0, 0),
-                android.graphics.Color.argb(0, 0, 0, 0)
-            ),
-            null,
-            Shader.TileMode.CLAMP
-        )
-
-        // Crease shadow: subtle dark at fold line, fading toward flat side
-        val creaseShadowGradient = LinearGradient(
-            mx, my,
-            mx - nx * creaseShadowW, my - ny * creaseShadowW,
-            intArrayOf(
-                android.graphics.Color.argb(CREASE_SHADOW_ALPHA, 0, 0, 0),
-                android.graphics.Color.argb(0, 0, 0, 0)
-            ),
-            null,
-            Shader.TileMode.CLAMP
-        )
-
-        // Shadow strip region on curl side of fold
-        val shadowRegion = buildShadowStrip(
-            mx, my, nx, ny, fldx, fldy, castShadowW, pageW, pageH
-        )
-
-        // Crease strip region on flat side of fold
-        val creaseRegion = buildShadowStrip(
-            mx, my, -nx, -ny, fldx, fldy, creaseShadowW, pageW, pageH
-        )
-
-        // Curl strip: narrow band on curl side representing the visible curl cylinder
         val curlStripW = pageW * CURL_STRIP_FRACTION
-        val curlStripPath = buildShadowStrip(
-            mx, my, nx, ny, fldx, fldy, curlStripW, pageW, pageH
-        )
-
-        // Highlight gradient for 3D cylinder illusion on the curl strip
-        val curlHighlightGradient = LinearGradient(
-            mx, my,
-            mx + nx * curlStripW, my + ny * curlStripW,
-            intArrayOf(
-                android.graphics.Color.argb(60, 255, 255, 255),  // bright at fold edge
-                android.graphics.Color.argb(0, 128, 128, 128),   // neutral center
-                android.graphics.Color.argb(80, 0, 0, 0)         // shadow at outer edge
-            ),
-            floatArrayOf(0f, 0.35f, 1f),
-            Shader.TileMode.CLAMP
-        )
-
-        return CurlFrame(
-            flatPath = flatPath,
-            backPath = curlPath,
-            backMatrix = backMatrix,
-            castShadowGradient = castShadowGradient,
-            creaseShadowGradient = creaseShadowGradient,
-            shadowRegionPath = shadowRegion,
-            creaseRegionPath = creaseRegion,
-            curlStripPath = curlStripPath,
-            curlHighlightGradient = curlHighlightGradient,
-            isVisible = true
-        )
+        frame.castShadowWidth = castShadowW
+        frame.creaseShadowWidth = creaseShadowW
+        frame.curlStripWidth = curlStripW
+        placeGradient(frame, frame.castShadowGradient, mx, my, nx, ny, castShadowW)
+        placeGradient(frame, frame.creaseShadowGradient, mx, my, -nx, -ny, creaseShadowW)
+        placeGradient(frame, frame.curlHighlightGradient, mx, my, nx, ny, curlStripW)
+
+        var slot = offset + CurlGeometry.POLYGONS
+        frame.flatVertexCount = loadPolygon(records, slot, frame.flatVerts, frame.flatPath)
+        slot += CurlGeometry.POLYGON_STRIDE
+        frame.curlVertexCount = loadPolygon(records, slot, frame.curlVerts, frame.backPath)
+        slot += CurlGeometry.POLYGON_STRIDE
+        frame.shadowVertexCount = loadPolygon(records, slot, frame.shadowVerts, frame.shadowRegionPath)
+        slot += CurlGeometry.POLYGON_STRIDE
+        frame.creaseVertexCount = loadPolygon(records, slot, frame.creaseVerts, frame.creaseRegionPath)
+        slot += CurlGeometry.POLYGON_STRIDE
+        frame.curlStripVertexCount = loadPolygon(records, slot, frame.curlStripVerts, frame.curlStripPath)
+
+        computeDirtyBounds(frame, pageW, pageH)
+        frame.isVisible = true
     }
 
-    /** Returns a CurlFrame representing a fully flat page (no curl). */
-    private fun noCurl(pageW: Float, pageH: Float): CurlFrame {
-        val full = Path().apply { addRect(0f, 0f, pageW, pageH, Path.Direction.CW) }
-        return CurlFrame(
-            flatPath = full,
-            backPath = Path(),
-            backMatrix = Matrix(),
-            castShadowGradient = null,
-            creaseShadowGradient = null,
-            shadowRegionPath = Path(),
-            creaseRegionPath = Path(),
-            curlStripPath = Path(),
-            curlHighlightGradient = null,
-            isVisible = false
-        )
+    /** Copy one (count, x0, y0, ...) record slot into [dst] and [path]; returns the count. */
+    private fun loadPolygon(records: FloatArray, slot: Int, dst: FloatArray, path: Path): Int {
+        val count = records[slot].toInt()
+        records.copyInto(dst, 0, slot + 1, slot + 1 + count * 2)
+        pointsToPath(dst, count, path)
+        return count
     }
 
     // -----------------------------------------------------------------------
-    // Region polygon construction
+    // Cylinder deformation
     // -----------------------------------------------------------------------
 
     /**
-     * Split the page rectangle into two polygons along the fold line.
+     * Number of strips to split the half-turn of a cylinder of [radius] pixels
+     * into, so that no chord strays more than [CHORD_TOLERANCE_PX] from the arc.
      *
-     * Walks the page corners clockwise (TL → TR → BR → BL). When the fold
-     * line crosses an edge (i.e., consecutive corners are on different sides),
-     * the intersection point is inserted into both polygons.
+     * Large radii on high-resolution screens get more strips; the count is
+     * also capped by display [density] so low-end devices stay cheap.
      */
-    private fun buildRegionPaths(
-        foldP1: PointF,
-        foldP2: PointF,
-        pageW: Float,
-        pageH: Float,
-        isFlat: (Float, Float) -> Boolean
-    ): Pair<Path, Path> {
-        val corners = arrayOf(
-            PointF(0f, 0f),       // TL
-            PointF(pageW, 0f),    // TR
-            PointF(pageW, pageH), // BR
-            PointF(0f, pageH)     // BL
-        )
-
-        val flatVerts = mutableListOf<PointF>()
-        val curlVerts = mutableListOf<PointF>()
-
-        for (i in corners.indices) {
-            val c1 = corners[i]
-            val c2 = corners[(i + 1) % 4]
-            val c1Flat = isFlat(c1.x, c1.y)
-            val c2Flat = isFlat(c2.x, c2.y)
-
-            // Add the current corner to its side
-            if (c1Flat) flatVerts.add(c1) else curlVerts.add(c1)
+    fun cylinderSegments(radius: Float, density: Float): Int {
+        val maxSegments = (density * SEGMENTS_PER_DENSITY).toInt()
+            .coerceIn(MIN_CYLINDER_SEGMENTS, MAX_CYLINDER_SEGMENTS)
+        if (radius <= CHORD_TOLERANCE_PX) return MIN_CYLINDER_SEGMENTS
+        val step = 2f * acos(1f - CHORD_TOLERANCE_PX / radius)
+        val segments = ceil(PI / step).toInt().coerceIn(MIN_CYLINDER_SEGMENTS, maxSegments)
+        // Even, so the quarter turn (front/back boundary) falls on a strip edge
+        return (segments + 1) and 1.inv()
+    }
 
-            // If the fold line crosses this edge, insert the intersection
-            if (c1Flat != c2Flat) {
-                lineSegmentIntersection(foldP1, foldP2, c1, c2)?.let {
-                    flatVerts.add(it)
-                    curlVerts.add(it)
-                }
+    /**
+     * Wrap the curl region of a visible [frame] around a cylinder of [radius]
+     * pixels whose axis runs parallel to the fold line, writing a
+     * strip-subdivided mesh into [mesh].
+     *
+     * The axis sits up to a quarter-circumference behind the fold line so the
+     * rolled-over corner lands near the touch point. Points past the axis are
+     * wrapped onto the cylinder in [segments] strips; points past the half
+     * turn lie flat on top, face down.
+     */
+    fun calculateCylinderInto(
+        mesh: CylinderMesh,
+        frame: CurlFrame,
+        radius: Float,
+        segments: Int,
+        pageW: Float
+    ) {
+        mesh.reset()
+        if (!frame.isVisible || radius <= 0f || segments < 1) return
+
+        val nx = frame.normalX
+        val ny = frame.normalY
+        val arc = PI.toFloat() * radius
+        val offset = -min(frame.cornerDistance, arc / 2f)
+        val ax = frame.foldX + nx * offset
+        val ay = frame.foldY + ny * offset
+
+        val corners = frame.pageCorners
+        val out = mesh.clipOut
+
+        // Revealed page under everything that has lifted off
+        var n = CurlGeometry.clipHalfPlane(corners, 4, ax, ay, nx, ny, out)
+        mesh.revealed.addPolygon(out, n, OPAQUE_WHITE)
+
+        // Flat part of the current page
+        n = CurlGeometry.clipHalfPlane(corners, 4, ax, ay, -nx, -ny, out)
+        mesh.front.addPolygon(out, n, OPAQUE_WHITE)
+
+        // Cast shadow just past the cylinder's silhouette, crease shadow before the axis
+        val castShadowW = pageW * CAST_SHADOW_FRACTION
+        val creaseShadowW = pageW * CREASE_SHADOW_FRACTION
+        n = clipBand(mesh, corners, ax, ay, nx, ny, radius, radius + castShadowW)
+        mesh.shadows.addRamp(
+            out, n, ax + nx * radius, ay + ny * radius, nx, ny, castShadowW, CAST_SHADOW_ALPHA
+        )
+        n = clipBand(mesh, corners, ax, ay, nx, ny, -creaseShadowW, 0f)
+        mesh.shadows.addRamp(out, n, ax, ay, -nx, -ny, creaseShadowW, CREASE_SHADOW_ALPHA)
+
+        // Cylinder strips in order of increasing lift, then the flat face-down flap on top
+        val step = arc / segments
+        for (k in 0 until segments) {
+            n = clipBand(mesh, corners, ax, ay, nx, ny, k * step, (k + 1) * step)
+            addWrappedPolygon(mesh.curl, out, n, ax, ay, nx, ny, radius, arc)
+            if (k >= segments / 2) {
+                // Past the quarter turn the underside faces the viewer
+                addWrappedPolygon(mesh.overlay, out, n, ax, ay, nx, ny, radius, arc, overlay = true)
             }
         }
+        n = CurlGeometry.clipHalfPlane(corners, 4, ax + nx * arc, ay + ny * arc, nx, ny, out)
+        addWrappedPolygon(mesh.curl, out, n, ax, ay, nx, ny, radius, arc)
+        addWrappedPolygon(mesh.overlay, out, n, ax, ay, nx, ny, radius, arc, overlay = true)
+    }
 
-        return Pair(pointsToPath(flatVerts), pointsToPath(curlVerts))
+    /** Clips the page [corners] to `lo <= (p - axis)·n <= hi` into [CylinderMesh.clipOut]. */
+    private fun clipBand(
+        mesh: CylinderMesh,
+        corners: FloatArray,
+        ax: Float, ay: Float, nx: Float, ny: Float,
+        lo: Float, hi: Float
+    ): Int {
+        val n = CurlGeometry.clipHalfPlane(corners, 4, ax + nx * lo, ay + ny * lo, nx, ny, mesh.clipScratch)
+        return CurlGeometry.clipHalfPlane(mesh.clipScratch, n, ax + nx * hi, ay + ny * hi, -nx, -ny, mesh.clipOut)
     }
 
-    private fun pointsToPath(points: List<PointF>): Path {
-        val path = Path()
-        if (points.size < 3) return path
-        path.moveTo(points[0].x, points[0].y)
-        for (i in 1 until points.size) {
-            path.lineTo(points[i].x, points[i].y)
+    /**
+     * Appends a convex polygon to [batch], sampling the page at each vertex's
+     * unwrapped position. Vertices past the axis move to their projection on
+     * the cylinder (or onto the face-down flap) and are shaded by their angle;
+     * with [overlay] they carry the paper-back tint instead.
+     */
+    private fun addWrappedPolygon(
+        batch: MeshBatch,
+        poly: FloatArray, count: Int,
+        ax: Float, ay: Float, nx: Float, ny: Float,
+        radius: Float, arc: Float,
+        overlay: Boolean = false
+    ) {
+        if (count < 3) return
+        val first = batch.vertexCount
+        for (i in 0 until count) {
+            val x = poly[i * 2]
+            val y = poly[i * 2 + 1]
+            val d = (x - ax) * nx + (y - ay) * ny
+            val projected: Float
+            val shade: Float
+            if (d <= arc) {
+                val theta = d.coerceAtLeast(0f) / radius
+                projected = radius * sin(theta)
+                val darken = if (theta <= PI.toFloat() / 2f) CYLINDER_FRONT_DARKEN else CYLINDER_BACK_DARKEN
+                shade = 1f - darken * sin(theta)
+            } else {
+                projected = -(d - arc)
+                shade = 1f
+            }
+            val color = if (overlay) {
+                BACK_OVERLAY_COLOR
+            } else {
+                val g = (shade * 255f + 0.5f).toInt().coerceIn(0, 255)
+                android.graphics.Color.argb(255, g, g, g)
+            }
+            batch.addVertex(x + nx * (projected - d), y + ny * (projected - d), x, y, color)
         }
-        path.close()
-        return path
+        batch.addFan(first, count)
     }
 
-    // -----------------------------------------------------------------------
-    // Line / segment intersection
-    // -----------------------------------------------------------------------
+    /** Resets [frame] to a fully flat page (no curl). */
+    private fun noCurl(frame: CurlFrame, pageW: Float, pageH: Float) {
+        frame.flatPath.rewind()
+        frame.flatPath.addRect(0f, 0f, pageW, pageH, Path.Direction.CW)
+        frame.backPath.rewind()
+        frame.backMatrix.reset()
+        frame.shadowRegionPath.rewind()
+        frame.creaseRegionPath.rewind()
+        frame.curlStripPath.rewind()
+        frame.flatVertexCount = 0
+        frame.curlVertexCount = 0
+        frame.shadowVertexCount = 0
+        frame.creaseVertexCount = 0
+        frame.curlStripVertexCount = 0
+        frame.dirtyBounds.setEmpty()
+        frame.isVisible = false
+    }
 
     /**
-     * Intersect an infinite line (through p1, p2) with a finite segment (p3→p4).
-     * Returns the intersection point if it lies on the segment, null otherwise.
+     * Fills [CurlFrame.dirtyBounds] from the region polygons. The back face
+     * is drawn inside the curl region (clipped to [CurlFrame.backPath], or
+     * emitted there by the mesh), so the curl polygon and the shadow bands
+     * cover everything the flat-fold renderers draw. Rounded outward with a
+     * pixel of margin for anti-aliased edges.
+     *
+     * Only covers what is drawn relative to the fold line: the cylinder's
+     * axis and crease band sit behind it, so that renderer repaints the
+     * whole page instead.
      */
-    private fun lineSegmentIntersection(
-        p1: PointF, p2: PointF,
-        p3: PointF, p4: PointF
-    ): PointF? {
-        val d1x = p2.x - p1.x
-        val d1y = p2.y - p1.y
-        val d2x = p4.x - p3.x
-        val d2y = p4.y - p3.y
-
-        val denom = d1x * d2y - d1y * d2x
-        if (abs(denom) < 0.001f) return null // parallel
-
-        // Parameter u is for the segment p3→p4; must be in [0, 1]
-        val u = ((p3.x - p1.x) * d1y - (p3.y - p1.y) * d1x) / denom
-        if (u < -0.001f || u > 1.001f) return null
-
-        val uc = u.coerceIn(0f, 1f)
-        return PointF(p3.x + uc * d2x, p3.y + uc * d2y)
+    private fun computeDirtyBounds(frame: CurlFrame, pageW: Float, pageH: Float) {
+        val b = frame.dirtyBounds
+        b.set(Float.MAX_VALUE, Float.MAX_VALUE, -Float.MAX_VALUE, -Float.MAX_VALUE)
+        includePoints(b, frame.curlVerts, frame.curlVertexCount)
+        includePoints(b, frame.creaseVerts, frame.creaseVertexCount)
+        includePoints(b, frame.shadowVerts, frame.shadowVertexCount)
+        includePoints(b, frame.curlStripVerts, frame.curlStripVertexCount)
+        if (b.left > b.right) {
+            b.setEmpty()
+            return
+        }
+        b.set(
+            (floor(b.left) - 1f).coerceAtLeast(0f),
+            (floor(b.top) - 1f).coerceAtLeast(0f),
+            (ceil(b.right) + 1f).coerceAtMost(pageW),
+            (ceil(b.bottom) + 1f).coerceAtMost(pageH)
+        )
+    }
+
+    private fun includePoints(b: RectF, verts: FloatArray, count: Int) {
+        for (i in 0 until count) includePoint(b, verts[i * 2], verts[i * 2 + 1])
+    }
+
+    private fun includePoint(b: RectF, x: Float, y: Float) {
+        if (x < b.left) b.left = x
+        if (x > b.right) b.right = x
+        if (y < b.top) b.top = y
+        if (y > b.bottom) b.bottom = y
     }
 
     // -----------------------------------------------------------------------
-    // Reflection matrix
+    // Paths
     // -----------------------------------------------------------------------
 
-    /**
-     * Build a 2D reflection matrix across a line through (mx, my)
-     * with direction (fldx, fldy).
-     *
-     * Formula: Translate(mx,my) * ReflectAboutOrigin(ux,uy) * Translate(-mx,-my)
-     */
-    private fun buildReflectionMatrix(
-        mx: Float, my: Float,
-        fldx: Float, fldy: Float
-    ): Matrix {
-        val len = sqrt(fldx * fldx + fldy * fldy)
-        if (len < 0.001f) return Matrix()
-        val ux = fldx / len
-        val uy = fldy / len
-
-        // Reflection across line through origin with unit direction (ux, uy):
-        //   | 2*ux²-1    2*ux*uy   0 |
-        //   | 2*ux*uy    2*uy²-1   0 |
-        //   | 0           0        1 |
-        // Combined with translate(-mx,-my) before and translate(mx,my) after:
-        val a = 2f * ux * ux - 1f
-        val b = 2f * ux * uy
-        val d = 2f * uy * uy - 1f
-        val tx = mx - a * mx - b * my
-        val ty = my - b * mx - d * my
-
-        return Matrix().apply {
-            setValues(
-                floatArrayOf(
-                    a, b, tx,
-                    b, d, ty,
-                    0f, 0f, 1f
-                )
-            )
+    private fun pointsToPath(points: FloatArray, count: Int, path: Path) {
+        path.rewind()
+        if (count < 3) return
+        path.moveTo(points[0], points[1])
+        for (i in 1 until count) {
+            path.lineTo(points[i * 2], points[i * 2 + 1])
         }
+        path.close()
     }
 
     // -----------------------------------------------------------------------
-    // Shadow strip geometry
+    // Shadow gradients
     // -----------------------------------------------------------------------
 
     /**
-     * Build a parallelogram strip along the fold line, offset in the
-     * given normal direction by [width] pixels.
+     * Position a unit gradient (defined from x=0 to x=1) so that it starts at
+     * (mx, my) and runs [width] pixels along (nx, ny).
      */
-    private fun buildShadowStrip(
+    private fun placeGradient(
+        frame: CurlFrame,
+        shader: Shader,
         mx: Float, my: Float,
-        nx: Float, ny: Float,         // offset direction
-        fldx: Float, fldy: Float,     // fold line direction
-        width: Float,
-        pageW: Float, pageH: Float
-    ): Path {
-        val ext = max(pageW, pageH) * 2f
-        val path = Path()
-        // Parallelogram: fold line → offset by width in normal direction
-        path.moveTo(mx - fldx * ext, my - fldy * ext)
-        path.lineTo(mx + fldx * ext, my + fldy * ext)
-        path.lineTo(mx + fldx * ext + nx * width, my + fldy * ext + ny * width)
-        path.lineTo(mx - fldx * ext + nx * width, my - fldy * ext + ny * width)
-        path.close()
-
-        // Clip to page bounds
-        val pagePath = Path()
-        pagePath.addRect(0f, 0f, pageW, pageH, Path.Direction.CW)
-        path.op(pagePath, Path.Op.INTERSECT)
-
-        return path
+        nx: Float, ny: Float,
+        width: Float
+    ) {
+        val v = frame.matrixValues
+        v[0] = nx * width; v[1] = -ny * width; v[2] = mx
+        v[3] = ny * width; v[4] = nx * width; v[5] = my
+        v[6] = 0f; v[7] = 0f; v[8] = 1f
+        frame.shaderMatrix.setValues(v)
+        shader.setLocalMatrix(frame.shaderMatrix)
     }
 }
@@ -0,0 +1,290 @@
+package io.github.readmigo.pagecurl
+
+/**
+ * A growable batch of triangles in the layout `Canvas.drawVertices` expects.
+ *
+ * Positions ([verts]) and texture coordinates ([texs]) are in page pixels;
+ * [colors] holds one ARGB value per vertex. Buffers only ever grow, so a
+ * warmed-up batch is refilled every frame without allocation.
+ */
+internal class MeshBatch(initialVertices: Int = 32) {
+    var verts = FloatArray(initialVertices * 2)
+        private set
+    var texs = FloatArray(initialVertices * 2)
+        private set
+    var colors = IntArray(initialVertices)
+        private set
+    var indices = ShortArray(initialVertices * 3)
+        private set
+
+    /** Number of logical (x, y) vertices. */
+    var vertexCount = 0
+        private set
+    var indexCount = 0
+        private set
+
+    val isEmpty: Boolean get() = indexCount == 0
+
+    fun reset() {
+        vertexCount = 0
+        indexCount = 0
+    }
+
+    /** Appends a vertex at (x, y) sampling the texture at (u, v); returns its index. */
+    fun addVertex(x: Float, y: Float, u: Float, v: Float, color: Int): Int {
+        if (vertexCount == colors.size) {
+            val capacity = colors.size * 2
+            verts = verts.copyOf(capacity * 2)
+            texs = texs.copyOf(capacity * 2)
+            colors = colors.copyOf(capacity)
+        }
+        val i = vertexCount
+        verts[i * 2] = x
+        verts[i * 2 + 1] = y
+        texs[i * 2] = u
+        texs[i * 2 + 1] = v
+        colors[i] = color
+        vertexCount++
+        return i
+    }
+
+    fun addTriangle(a: Int, b: Int, c: Int) {
+        if (indexCount + 3 > indices.size) indices = indices.copyOf(indices.size * 2)
+        indices[indexCount++] = a.toShort()
+        indices[indexCount++] = b.toShort()
+        indices[indexCount++] = c.toShort()
+    }
+
+    /** Triangulates the convex polygon whose [count] vertices start at index [first]. */
+    fun addFan(first: Int, count: Int) {
+        for (k in 1 until count - 1) addTriangle(first, first + k, first + k + 1)
+    }
+
+    /** Appends the convex polygon [poly] (sampling the page in place) in a single [color]. */
+    fun addPolygon(poly: FloatArray, count: Int, color: Int) {
+        if (count < 3) return
+        val first = vertexCount
+        for (i in 0 until count) {
+            val x = poly[i * 2]
+            val y = poly[i * 2 + 1]
+            addVertex(x, y, x, y, color)
+        }
+        addFan(first, count)
+    }
+
+    /**
+     * Appends the convex polygon [poly] shaded by a black ramp running from
+     * [alpha] at the line through (px, py) to transparent [width] pixels
+     * along (nx, ny).
+     */
+    fun addRamp(
+        poly: FloatArray, count: Int,
+        px: Float, py: Float, nx: Float, ny: Float,
+        width: Float, alpha: Int
+    ) {
+        if (count < 3 || width <= 0f) return
+        val first = vertexCount
+        for (i in 0 until count) {
+            val x = poly[i * 2]
+            val y = poly[i * 2 + 1]
+            val t = (((x - px) * nx + (y - py) * ny) / width).coerceIn(0f, 1f)
+            addVertex(x, y, x, y, (alpha * (1f - t) + 0.5f).toInt() shl 24)
+        }
+        addFan(first, count)
+    }
+}
+
+/**
+ * Triangle-mesh tessellation of a [CurlFrame] for [MeshCurlDrawer].
+ *
+ * The region polygons become triangle fans; the shadow and highlight
+ * gradients become per-vertex colors. Because each gradient is linear in
+ * the distance from the fold line, Gouraud interpolation across a fan
+ * reproduces it exactly (the 3-stop highlight is split at its middle stop).
+ */
+internal class CurlMesh {
+    /** Revealed page over the curl region (textured). */
+    val revealed = MeshBatch()
+    /** Flat region of the current page (textured). */
+    val front = MeshBatch()
+    /** Cast and crease shadows (colored). */
+    val shadows = MeshBatch()
+    /** Back face of the curled page (textured, sampled through the fold reflection). */
+    val back = MeshBatch()
+    /** Paper-back overlay and curl highlight over the curl region (colored). */
+    val overlay = MeshBatch()
+
+    private val clipA = FloatArray(MAX_CLIP_VERTICES * 2)
+    private val clipB = FloatArray(MAX_CLIP_VERTICES * 2)
+
+    /**
+     * Rebuilds every batch from [frame], which must be visible.
+     * @param backOverlay Add the paper-back overlay polygon; off when the
+     *                    back-face texture already has it baked in.
+     * @param highlight   Add the curl highlight fans.
+     * @param crease      Add the crease shadow ramp.
+     */
+    fun build(
+        frame: CurlFrame,
+        pageW: Float,
+        pageH: Float,
+        backOverlay: Boolean = true,
+        highlight: Boolean = true,
+        crease: Boolean = true
+    ) {
+        revealed.reset()
+        front.reset()
+        shadows.reset()
+        back.reset()
+        overlay.reset()
+
+        val mx = frame.foldX
+        val my = frame.foldY
+        val nx = frame.normalX
+        val ny = frame.normalY
+
+        revealed.addPolygon(frame.curlVerts, frame.curlVertexCount, OPAQUE_WHITE)
+        front.addPolygon(frame.flatVerts, frame.flatVertexCount, OPAQUE_WHITE)
+
+        // Cast shadow fades toward the curl side, crease shadow toward the flat side
+        shadows.addRamp(
+            frame.shadowVerts, frame.shadowVertexCount,
+            mx, my, nx, ny, frame.castShadowWidth, CurlMath.CAST_SHADOW_ALPHA
+        )
+        if (crease) {
+            shadows.addRamp(
+                frame.creaseVerts, frame.creaseVertexCount,
+                mx, my, -nx, -ny, frame.creaseShadowWidth, CurlMath.CREASE_SHADOW_ALPHA
+            )
+        }
+
+        buildBackFace(frame, mx, my, nx, ny, pageW, pageH)
+
+        if (backOverlay) overlay.addPolygon(frame.curlVerts, frame.curlVertexCount, BACK_OVERLAY_COLOR)
+        if (highlight) buildHighlight(frame, mx, my, nx, ny)
+    }
+
+    /**
+     * The Canvas renderer draws the back face by clipping to the curl region
+     * and sampling the page through the fold reflection, so only points whose
+     * reflection lands on the page show content. Here that region is built
+     * directly: reflect the curl polygon, clip it to the page, and emit each
+     * vertex at its reflected position sampling the unreflected point.
+     */
+    private fun buildBackFace(
+        frame: CurlFrame,
+        mx: Float, my: Float, nx: Float, ny: Float,
+        pageW: Float, pageH: Float
+    ) {
+        val count = frame.curlVertexCount
+        if (count < 3) return
+        val src = frame.curlVerts
+        for (i in 0 until count) {
+            val x = src[i * 2]
+            val y = src[i * 2 + 1]
+            val s2 = 2f * ((x - mx) * nx + (y - my) * ny)
+            clipA[i * 2] = x - s2 * nx
+            clipA[i * 2 + 1] = y - s2 * ny
+        }
+        var n = CurlGeometry.clipHalfPlane(clipA, count, 0f, 0f, 1f, 0f, clipB)
+        n = CurlGeometry.clipHalfPlane(clipB, n, pageW, 0f, -1f, 0f, clipA)
+        n = CurlGeometry.clipHalfPlane(clipA, n, 0f, 0f, 0f, 1f, clipB)
+        n = CurlGeometry.clipHalfPlane(clipB, n, 0f, pageH, 0f, -1f, clipA)
+        if (n < 3) return
+
+        val first = back.vertexCount
+        for (i in 0 until n) {
+            val u = clipA[i * 2]
+            val v = clipA[i * 2 + 1]
+            val s2 = 2f * ((u - mx) * nx + (v - my) * ny)
+            back.addVertex(u - s2 * nx, v - s2 * ny, u, v, OPAQUE_WHITE)
+        }
+        back.addFan(first, n)
+    }
+
+    /** 3-stop highlight over the curl strip, split at the middle stop. */
+    private fun buildHighlight(frame: CurlFrame, mx: Float, my: Float, nx: Float, ny: Float) {
+        val width = frame.curlStripWidth
+        val count = frame.curlStripVertexCount
+        if (count < 3 || width <= 0f) return
+        val midX = mx + nx * width * HIGHLIGHT_MID_STOP
+        val midY = my + ny * width * HIGHLIGHT_MID_STOP
+
+        // Near half: fold line to middle stop
+        var n = CurlGeometry.clipHalfPlane(frame.curlStripVerts, count, midX, midY, -nx, -ny, clipA)
+        addHighlightPolygon(n, mx, my, nx, ny, width)
+        // Far half: middle stop to outer edge
+        n = CurlGeometry.clipHalfPlane(frame.curlStripVerts, count, midX, midY, nx, ny, clipA)
+        addHighlightPolygon(n, mx, my, nx, ny, width)
+    }
+
+    private fun addHighlightPolygon(
+        count: Int, mx: Float, my: Float, nx: Float, ny: Float, width: Float
+    ) {
+        if (count < 3) return
+        val first = overlay.vertexCount
+        for (i in 0 until count) {
+            val x = clipA[i * 2]
+            val y = clipA[i * 2 + 1]
+            val t = (((x - mx) * nx + (y - my) * ny) / width).coerceIn(0f, 1f)
+            val color = if (t <= HIGHLIGHT_MID_STOP) {
+                lerpArgb(HIGHLIGHT_EDGE, HIGHLIGHT_MID, t / HIGHLIGHT_MID_STOP)
+            } else {
+                lerpArgb(HIGHLIGHT_MID, HIGHLIGHT_OUTER, (t - HIGHLIGHT_MID_STOP) / (1f - HIGHLIGHT_MID_STOP))
+            }
+            overlay.addVertex(x, y, x, y, color)
+        }
+        overlay.addFan(first, count)
+    }
+
+    private fun lerpArgb(from: Int, to: Int, f: Float): Int {
+        fun channel(shift: Int): Int {
+            val a = (from ushr shift) and 0xFF
+            val b = (to ushr shift) and 0xFF
+            return (a + (b - a) * f + 0.5f).toInt() shl shift
+        }
+        return channel(24) or channel(16) or channel(8) or channel(0)
+    }
+
+    private companion object {
+        /** Reflected curl polygon (≤ 6 vertices) clipped by four page edges. */
+        const val MAX_CLIP_VERTICES = 12
+
+        const val OPAQUE_WHITE = -0x1 // 0xFFFFFFFF
+        val BACK_OVERLAY_COLOR = android.graphics.Color.argb(BACK_FACE_OVERLAY_ALPHA, 255, 255, 255)
+
+        // Same stops as CurlFrame.curlHighlightGradient
+        const val HIGHLIGHT_MID_STOP = 0.35f
+        val HIGHLIGHT_EDGE = android.graphics.Color.argb(60, 255, 255, 255)
+        val HIGHLIGHT_MID = android.graphics.Color.argb(0, 128, 128, 128)
+        val HIGHLIGHT_OUTER = android.graphics.Color.argb(80, 0, 0, 0)
+    }
+}
+
+/**
+ * Cylinder-wrap tessellation of a curl, filled by
+ * [CurlMath.calculateCylinderInto] and drawn by [CylinderCurlDrawer].
+ */
+internal class CylinderMesh {
+    /** Revealed page over the lifted region (textured). */
+    val revealed = MeshBatch()
+    /** Flat region of the current page before the cylinder axis (textured). */
+    val front = MeshBatch()
+    /** Cast and crease shadows (colored). */
+    val shadows = MeshBatch()
+    /** Cylinder strips and the face-down flap, in painter's order (textured, color-modulated). */
+    val curl = MeshBatch(initialVertices = 128)
+    /** Paper-back overlay over the underside of the curl (colored). */
+    val overlay = MeshBatch(initialVertices = 64)
+
+    internal val clipScratch = FloatArray(CurlFrame.MAX_POLYGON_VERTICES * 2)
+    internal val clipOut = FloatArray(CurlFrame.MAX_POLYGON_VERTICES * 2)
+
+    fun reset() {
+        revealed.reset()
+        front.reset()
+        shadows.reset()
+        curl.reset()
+        overlay.reset()
+    }
+}
@@ -0,0 +1,53 @@
+package io.github.readmigo.pagecurl
+
+import android.util.Log
+
+private const val TAG = "PageCurl"
+
+/**
+ * JNI entry points of the native geometry kernel (`libpagecurl.so`, see
+ * `src/main/cpp/curl_kernel.h`).
+ *
+ * The record layout constants mirror the header and are checked against it
+ * when the library loads.
+ */
+internal object CurlNative {
+
+    // ---- Record layout (floats), must match curl_kernel.h; see CurlGeometry ----
+    const val VISIBLE = CurlGeometry.VISIBLE
+    const val FOLD_X = CurlGeometry.FOLD_X
+    const val FOLD_Y = CurlGeometry.FOLD_Y
+    const val NORMAL_X = CurlGeometry.NORMAL_X
+    const val NORMAL_Y = CurlGeometry.NORMAL_Y
+    const val CORNER_DISTANCE = CurlGeometry.CORNER_DISTANCE
+    const val MATRIX = CurlGeometry.MATRIX
+    const val POLYGONS = CurlGeometry.POLYGONS
+    const val POLYGON_STRIDE = CurlGeometry.POLYGON_STRIDE
+    const val RECORD_STRIDE = CurlGeometry.RECORD_STRIDE
+
+    /** Whether the kernel loaded and agrees on the record layout. */
+    val isAvailable: Boolean by lazy {
+        try {
+            System.loadLibrary("pagecurl")
+            val stride = nativeRecordStride()
+            if (stride != RECORD_STRIDE) Log.w(TAG, "native record stride $stride != $RECORD_STRIDE")
+            stride == RECORD_STRIDE
+        } catch (e: UnsatisfiedLinkError) {
+            Log.w(TAG, "native geometry unavailable: ${e.message}")
+            false
+        }
+    }
+
+    external fun nativeRecordStride(): Int
+
+    /**
+     * Fills [out] with [frames] records for corner positions evenly spaced
+     * from (startX, startY) to (endX, endY). Returns the frames written.
+     */
+    external fun nativeBuildTrajectory(
+        out: FloatArray, frames: Int,
+        startX: Float, startY: Float, endX: Float, endY: Float,
+        cornerX: Float, pageW: Float, pageH: Float,
+        castShadowW: Float, creaseShadowW: Float, curlStripW: Float
+    ): Int
+}
@@ -0,0 +1,30 @@
+package io.github.readmigo.pagecurl
+
+/**
+ * Rendering quality tier for curl frames, trading back-face and shadow
+ * fidelity for fill rate.
+ *
+ * The back face is mirrored and covered by a paper-white overlay, so most
+ * of its detail is never visible: the lower tiers draw it from a cached
+ * downsampled copy of the page with the overlay baked in (one layer fewer),
+ * and fill the shadow regions without anti-aliasing.
+ */
+enum class CurlQuality(internal val backFaceScale: Int) {
+    /** Use [BALANCED] on low-RAM devices and [HIGH] elsewhere. */
+    AUTO(0),
+
+    /** Full-resolution back face, anti-aliased shadows. */
+    HIGH(1),
+
+    /** Back face from a half-resolution copy; path-filled shadows (below API 29) without anti-aliasing. */
+    BALANCED(2),
+
+    /** Back face from a quarter-resolution copy; path-filled shadows (below API 29) without anti-aliasing. */
+    LOW(4);
+
+    /** Resolves [AUTO] for this device; other tiers map to themselves. */
+    internal fun resolve(lowRamDevice: Boolean): CurlQuality = when (this) {
+        AUTO -> if (lowRamDevice) BALANCED else HIGH
+        else -> this
+    }
+}
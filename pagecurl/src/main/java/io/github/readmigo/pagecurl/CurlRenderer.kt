@@ -0,0 +1,45 @@
+package io.github.readmigo.pagecurl
+
+/**
+ * Rendering backend used by [PageCurlContainer] to draw a curl frame.
+ *
+ * Both backends consume the same [CurlMath] geometry, so they can be
+ * swapped at runtime to compare frame time on a given device.
+ */
+sealed interface CurlRenderer {
+
+    /**
+     * Clip-path renderer: each layer is a bitmap or gradient fill under a
+     * `save/clipPath/restore` cycle.
+     */
+    data object Canvas : CurlRenderer
+
+    /**
+     * Triangle-mesh renderer: the flat, revealed and back-face regions are
+     * tessellated and drawn with `Canvas.drawVertices`, with the shadows and
+     * highlight baked into per-vertex colors. No clip paths are used.
+     *
+     * Requires API 29 for hardware-accelerated vertex drawing; falls back
+     * to [Canvas] on older devices.
+     */
+    data object Mesh : CurlRenderer
+
+    /**
+     * True cylinder-wrap curl: the page rolls around a cylinder whose axis
+     * runs along the fold line, tessellated into strips that adapt to the
+     * radius and display density. Drawn as a mesh like [Mesh], with the
+     * same API 29 requirement and [Canvas] fallback.
+     *
+     * @property radiusFraction Cylinder radius as a fraction of page width.
+     */
+    data class Cylinder(val radiusFraction: Float = DEFAULT_RADIUS_FRACTION) : CurlRenderer {
+        init {
+            require(radiusFraction > 0f) { "radiusFraction must be positive, was $radiusFraction" }
+        }
+
+        companion object {
+            /** Matches the width of the Canvas renderer's curl highlight strip. */
+            const val DEFAULT_RADIUS_FRACTION = 0.08f
+        }
+    }
+}
@@ -0,0 +1,177 @@
+package io.github.readmigo.pagecurl
+
+import kotlin.math.abs
+import kotlin.math.hypot
+import kotlin.math.roundToInt
+
+/**
+ * Precomputed geometry of an animated turn.
+ *
+ * Animated turns move the corner along a straight line, so the whole path
+ * is known when the animation starts: [prepare] computes [frames] evenly
+ * spaced frames up front, and [loadInto] copies the record at the
+ * animation progress into a [CurlFrame] instead of recomputing it.
+ *
+ * Progress is already eased, so the corner crawls through records in the
+ * ease tail and skips several per frame in the middle. A progress that
+ * falls between records by more than [SNAP_PX] is computed exactly from
+ * the corner position on the path, so the tail never freezes on one
+ * record and then jumps to the next.
+ *
+ * Records use the native kernel's layout (see [CurlGeometry]). With
+ * [useNative] they are built in one native pass, otherwise by running
+ * [CurlGeometry.computeInto] for each frame.
+ */
+internal class CurlTrajectory(
+    private val frames: Int = DEFAULT_FRAMES,
+    private val useNative: Boolean = true
+) {
+
+    private val records = FloatArray(frames * CurlNative.RECORD_STRIDE)
+    private var valid = false
+
+    // Inputs the records were built from
+    private var startX = Float.NaN
+    private var startY = Float.NaN
+    private var endX = Float.NaN
+    private var endY = Float.NaN
+    private var cornerX = Float.NaN
+    private var pageW = 0f
+    private var pageH = 0f
+    /** Corner travel between consecutive records, in px. */
+    private var spacing = 0f
+
+    private var loadedIndex = -1
+    private var loadedGeneration = -1
+
+    // Kotlin builder's scratch, allocated on first use
+    private var scratch: FloatArray? = null
+
+    /** Whether the records are valid for a page of this size. */
+    fun isBuiltFor(pageW: Float, pageH: Float): Boolean =
+        valid && pageW == this.pageW && pageH == this.pageH
+
+    /**
+     * Builds the records for this path unless they are already current.
+     * @return false if the native kernel failed, in which case callers
+     *         compute frames in Kotlin.
+     */
+    fun prepare(
+        startX: Float, startY: Float,
+        endX: Float, endY: Float,
+        cornerX: Float,
+        pageW: Float, pageH: Float
+    ): Boolean {
+        if (startX == this.startX && startY == this.startY && endX == this.endX &&
+            endY == this.endY && cornerX == this.cornerX &&
+            pageW == this.pageW && pageH == this.pageH
+        ) {
+            return valid
+        }
+        this.startX = startX
+        this.startY = startY
+        this.endX = endX
+        this.endY = endY
+        this.cornerX = cornerX
+        this.pageW = pageW
+        this.pageH = pageH
+        spacing = hypot(endX - startX, endY - startY) / (frames - 1)
+        loadedIndex = -1
+        valid = if (useNative) buildNative() else buildInKotlin()
+        return valid
+    }
+
+    /** Loads the frame at animation progress [t] (0..1) into [frame]. */
+    fun loadInto(frame: CurlFrame, t: Float) {
+        val position = t.coerceIn(0f, 1f) * (frames - 1)
+        val index = position.roundToInt()
+        if (abs(position - index) * spacing > SNAP_PX) {
+            // Between records: compute the frame at the exact corner position
+            val p = position / (frames - 1)
+            val ex = startX + (endX - startX) * p
+            val ey = startY + (endY - startY) * p
+            val cornerY = if (ey < pageH / 2) 0f else pageH
+            CurlMath.updateInto(frame, ex, ey, cornerX, cornerY, pageW, pageH)
+            loadedIndex = -1
+            return
+        }
+        if (index == loadedIndex && frame.generation == loadedGeneration) return
+        CurlMath.loadRecord(frame, records, index * CurlNative.RECORD_STRIDE, pageW, pageH)
+        loadedIndex = index
+        loadedGeneration = frame.generation
+    }
+
+    private fun buildNative(): Boolean = CurlNative.nativeBuildTrajectory(
+        records, frames,
+        startX, startY, endX, endY,
+        cornerX, pageW, pageH,
+        pageW * CurlMath.CAST_SHADOW_FRACTION,
+        pageW * CurlMath.CREASE_SHADOW_FRACTION,
+        pageW * CurlMath.CURL_STRIP_FRACTION
+    ) == frames
+
+    private fun buildInKotlin(): Boolean {
+        val buffer = scratch ?: FloatArray(CurlGeometry.SCRATCH_SIZE).also { scratch = it }
+        val step = 1f / (frames - 1)
+        for (i in 0 until frames) {
+            val t = i * step
+            val ex = startX + (endX - startX) * t
+            val ey = startY + (endY - startY) * t
+            // Same corner rule as the container's draw pass
+            val cornerY = if (ey < pageH / 2) 0f else pageH
+            CurlGeometry.computeInto(
+                records, i * CurlNative.RECORD_STRIDE,
+                ex, ey, cornerX, cornerY, pageW, pageH,
+                pageW * CurlMath.CAST_SHADOW_FRACTION,
+                pageW * CurlMath.CREASE_SHADOW_FRACTION,
+                pageW * CurlMath.CURL_STRIP_FRACTION,
+                buffer
+            )
+        }
+        return true
+    }
+
+    companion object {
+        /** Corner steps of ~9 px on a phone-sized turn; ~86 KB of records. */
+        const val DEFAULT_FRAMES = 256
+        /** Largest distance from a record that [loadInto] still snaps across. */
+        const val SNAP_PX = 0.5f
+    }
+}
+
+/**
+ * Keyframe tables for the fixed tap-to-turn trajectories: forward from the
+ * bottom-right corner and backward from the bottom-left one, each ending
+ * past the opposite edge (the corner rule switches to the top corner as
+ * the path crosses mid-height, so both corners are covered).
+ *
+ * Rebuilt only when the page size changes, so a tap turn costs a table
+ * lookup per frame.
+ */
+internal class TapTurnTables {
+
+    val forward = CurlTrajectory(TAP_FRAMES, useNative = false)
+    val backward = CurlTrajectory(TAP_FRAMES, useNative = false)
+
+    fun rebuild(pageW: Float, pageH: Float) {
+        if (pageW <= 0f || pageH <= 0f) return
+        forward.prepare(
+            pageW, pageH,
+            -pageW * OVERSHOOT, pageH * END_Y_FRACTION,
+            pageW, pageW, pageH
+        )
+        backward.prepare(
+            0f, pageH,
+            pageW * (1f + OVERSHOOT), pageH * END_Y_FRACTION,
+            0f, pageW, pageH
+        )
+    }
+
+    companion object {
+        /** How far past the opposite edge a tap turn ends, as a fraction of page width. */
+        const val OVERSHOOT = 0.3f
+        /** Height a tap turn ends at, as a fraction of page height. */
+        const val END_Y_FRACTION = 0.25f
+        private const val TAP_FRAMES = 128
+    }
+}
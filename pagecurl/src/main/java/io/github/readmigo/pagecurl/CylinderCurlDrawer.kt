@@ -0,0 +1,76 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.graphics.RectF
+import android.os.Build
+import androidx.annotation.RequiresApi
+
+/**
+ * [CurlDrawer] for [CurlRenderer.Cylinder]: wraps the curl region around a
+ * cylinder with [CurlMath.calculateCylinderInto] and draws the resulting
+ * strip mesh with `drawVertices`, shading each strip by its angle.
+ *
+ * @param radiusFraction Cylinder radius as a fraction of page width.
+ * @param density        Display density, caps the strip count.
+ */
+@RequiresApi(Build.VERSION_CODES.Q)
+internal class CylinderCurlDrawer(
+    private val radiusFraction: Float,
+    private val density: Float
+) : CurlDrawer {
+
+    private val mesh = CylinderMesh()
+    private val currentShader = PageShader()
+    private val revealedShader = PageShader()
+
+    private val texturePaint = Paint(Paint.FILTER_BITMAP_FLAG)
+    private val colorPaint = Paint()
+
+    // Strip count only changes with page width
+    private var segmentsForWidth = -1f
+    private var segments = 0
+
+    // Frame generation the mesh was last built from
+    private var builtGeneration = -1
+
+    override fun draw(
+        canvas: Canvas,
+        frame: CurlFrame,
+        current: Bitmap?,
+        revealed: Bitmap?,
+        dst: RectF,
+        stepDown: Int
+    ) {
+        val pageW = dst.width()
+        val radius = pageW * radiusFraction
+        if (pageW != segmentsForWidth) {
+            segments = CurlMath.cylinderSegments(radius, density)
+            segmentsForWidth = pageW
+            builtGeneration = -1
+        }
+        if (frame.generation != builtGeneration) {
+            CurlMath.calculateCylinderInto(mesh, frame, radius, segments, pageW)
+            builtGeneration = frame.generation
+        }
+
+        if (revealed != null) {
+            texturePaint.shader = revealedShader.shaderFor(revealed, dst)
+            drawTextured(canvas, mesh.revealed, texturePaint)
+        }
+        if (current != null) {
+            texturePaint.shader = currentShader.shaderFor(current, dst)
+            drawTextured(canvas, mesh.front, texturePaint)
+        }
+        drawColored(canvas, mesh.shadows, colorPaint)
+        if (current != null) {
+            drawTextured(canvas, mesh.curl, texturePaint, modulate = true)
+        }
+        texturePaint.shader = null
+        drawColored(canvas, mesh.overlay, colorPaint)
+    }
+
+    override fun holds(bitmap: Bitmap): Boolean =
+        currentShader.holds(bitmap) || revealedShader.holds(bitmap)
+}
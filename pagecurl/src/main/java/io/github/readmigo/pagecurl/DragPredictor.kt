@@ -0,0 +1,82 @@
+package io.github.readmigo.pagecurl
+
+import android.view.MotionEvent
+import android.view.View
+import androidx.input.motionprediction.MotionEventPredictor
+
+/**
+ * Predicts where the dragging finger will be when the next frame is shown,
+ * so the curl corner can be drawn there instead of one frame behind.
+ *
+ * Every [MotionEvent] reaching the container is [record]ed; [predict] then
+ * yields the offset from the last real touch to the predicted one, which
+ * the draw pass adds to the dragged corner. The offset is capped at
+ * [maxOffset] so a misprediction at a direction change cannot fling the
+ * corner.
+ *
+ * Each prediction is a new [MotionEvent]; [predict] asks for one only when
+ * a touch was recorded since the last call, keeps its coordinates and
+ * recycles it right away.
+ *
+ * @param maxOffset Largest predicted offset per axis, in pixels.
+ */
+internal class DragPredictor(view: View, private val maxOffset: Float) {
+
+    private val predictor = MotionEventPredictor.newInstance(view)
+    private var lastX = 0f
+    private var lastY = 0f
+    private var tracking = false
+    // A touch was recorded since the last prediction
+    private var fresh = false
+
+    /** Predicted offset from the last recorded touch; valid after [predict]. */
+    var dx = 0f
+        private set
+    var dy = 0f
+        private set
+
+    fun record(event: MotionEvent) {
+        predictor.record(event)
+        when (event.actionMasked) {
+            MotionEvent.ACTION_DOWN, MotionEvent.ACTION_MOVE -> {
+                lastX = event.x
+                lastY = event.y
+                tracking = true
+                fresh = true
+            }
+            MotionEvent.ACTION_UP, MotionEvent.ACTION_CANCEL -> tracking = false
+        }
+    }
+
+    /**
+     * Refreshes [dx]/[dy]; both are zero when no prediction is available.
+     * Without a new touch since the last call the previous offset stands.
+     */
+    fun predict() {
+        if (!tracking) {
+            dx = 0f
+            dy = 0f
+            return
+        }
+        if (!fresh) return
+        fresh = false
+        dx = 0f
+        dy = 0f
+        val predicted = predictor.predict() ?: return
+        val x: Float
+        val y: Float
+        try {
+            x = predicted.x
+            y = predicted.y
+        } finally {
+            predicted.recycle()
+        }
+        dx = (x - lastX).coerceIn(-maxOffset, maxOffset)
+        dy = (y - lastY).coerceIn(-maxOffset, maxOffset)
+    }
+
+    companion object {
+        /** Default cap on the predicted offset, in dp. */
+        const val MAX_OFFSET_DP = 32f
+    }
+}
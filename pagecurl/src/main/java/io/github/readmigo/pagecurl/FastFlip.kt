@@ -0,0 +1,212 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.graphics.RectF
+import androidx.compose.animation.core.FastOutSlowInEasing
+import androidx.compose.runtime.getValue
+import androidx.compose.runtime.mutableLongStateOf
+import androidx.compose.runtime.mutableStateOf
+import androidx.compose.runtime.setValue
+import androidx.compose.runtime.withFrameNanos
+import kotlinx.coroutines.channels.Channel
+
+/**
+ * Batched animation for runs of queued turns: the leaves peel off one after
+ * another as a single stacked animation instead of a full turn per page.
+ *
+ * Leaves start [STAGGER_MILLIS] apart, compressed so the whole backlog
+ * starts within [BACKLOG_MILLIS]. Pages that would start in the same frame
+ * as the leaf above them would be covered by it for their whole flight, so
+ * they get no leaf at all and are never read from the page provider; the
+ * container points its prefetch window at [targetPage] instead of at them.
+ *
+ * Leaves are drawn light: only the front of the flat region and the cast
+ * shadow, no back face, crease or highlight. Everything runs on one
+ * frame-clock loop like [TurnEngine], with fixed leaf slots and frames.
+ */
+internal class FastFlip {
+
+    /** Frame time of the latest step; the state the draw pass observes. */
+    var frameNanos by mutableLongStateOf(0L)
+        private set
+    var isRunning by mutableStateOf(false)
+        private set
+
+    var forward = true
+        private set
+    /** Page the flip started from. */
+    var fromPage = 0
+        private set
+    /** Pages still to start, after [nextPage]. */
+    var remaining = 0
+        private set
+    /** First page not yet peeled off: drawn flat under all leaves in flight. */
+    var nextPage = 0
+        private set
+
+    /** Page the flip settles on once every leaf has landed. */
+    val targetPage: Int get() = if (forward) nextPage + remaining else nextPage - remaining
+
+    // Leaves in flight, oldest (topmost) first, in a fixed ring of slots
+    private val leafPages = IntArray(MAX_LEAVES)
+    private val leafStarts = LongArray(MAX_LEAVES)
+    private val frames = Array(MAX_LEAVES) { CurlFrame() }
+    private var first = 0
+    private var inFlight = 0
+    private var lastStartNanos = -1L
+
+    private val leafPaint = Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG)
+    private val paperPaint = Paint()
+    private val shadowPaint = Paint(Paint.ANTI_ALIAS_FLAG)
+
+    private val wake = Channel<Unit>(Channel.CONFLATED)
+    private var onSettled: (forward: Boolean, page: Int) -> Unit = { _, _ -> }
+    private val frameCallback: (Long) -> Unit = { now -> step(now) }
+
+    /** Starts flipping [count] pages from [fromPage]. */
+    fun start(forward: Boolean, fromPage: Int, count: Int) {
+        this.forward = forward
+        this.fromPage = fromPage
+        nextPage = fromPage
+        remaining = count
+        first = 0
+        inFlight = 0
+        lastStartNanos = -1L
+        isRunning = true
+        wake.trySend(Unit)
+    }
+
+    /** Adds one page to the run. */
+    fun extend() {
+        remaining++
+    }
+
+    /** Drops one page that has not started yet. @return false if none was left. */
+    fun shrink(): Boolean {
+        if (remaining == 0) return false
+        remaining--
+        return true
+    }
+
+    /** Drops the run where it is, without settling. @return false if none was running. */
+    fun stop(): Boolean {
+        if (!isRunning) return false
+        isRunning = false
+        remaining = 0
+        inFlight = 0
+        return true
+    }
+
+    /** Drives flips until cancelled; [onSettled] gets the page the run ends on. */
+    suspend fun run(onSettled: (forward: Boolean, page: Int) -> Unit) {
+        this.onSettled = onSettled
+        while (true) {
+            if (!isRunning) {
+                wake.receive()
+                continue
+            }
+            withFrameNanos(frameCallback)
+        }
+    }
+
+    private fun step(now: Long) {
+        if (!isRunning) return
+        startLeaves(now)
+        // Land the leaves that finished; they are the oldest
+        while (inFlight > 0 && now - leafStarts[first] >= LEAF_NANOS) {
+            first = (first + 1) % MAX_LEAVES
+            inFlight--
+        }
+        frameNanos = now
+        if (inFlight == 0 && remaining == 0) {
+            isRunning = false
+            onSettled(forward, nextPage)
+        }
+    }
+
+    private fun startLeaves(now: Long) {
+        if (remaining == 0 || inFlight == MAX_LEAVES) return
+        val stagger = staggerNanos()
+        if (lastStartNanos >= 0L && now - lastStartNanos < stagger) return
+        // Every page due by now starts together; only the topmost gets a leaf
+        val due = if (lastStartNanos < 0L) 1 else ((now - lastStartNanos) / stagger).toInt()
+        val pages = due.coerceIn(1, remaining)
+        val slot = (first + inFlight) % MAX_LEAVES
+        leafPages[slot] = nextPage
+        leafStarts[slot] = now
+        inFlight++
+        lastStartNanos = now
+        remaining -= pages
+        nextPage = if (forward) nextPage + pages else nextPage - pages
+    }
+
+    private fun staggerNanos(): Long {
+        val compressed = BACKLOG_MILLIS * 1_000_000L / remaining.coerceAtLeast(1)
+        return minOf(STAGGER_MILLIS * 1_000_000L, compressed).coerceAtLeast(1L)
+    }
+
+    /**
+     * Draws the run: [nextPage] flat, then the leaves in flight from the
+     * bottom up. Leaves whose page is not loaded are drawn as blank paper.
+     */
+    fun draw(
+        canvas: Canvas,
+        dst: RectF,
+        pages: PageProvider,
+        fallback: SoftwareBitmapFallback,
+        paperColor: Int
+    ) {
+        val w = dst.width()
+        val h = dst.height()
+        val now = frameNanos
+        fallback.drawable(pages[nextPage], canvas)?.let { canvas.drawBitmap(it, null, dst, leafPaint) }
+        paperPaint.color = paperColor
+
+        val originX = if (forward) w else 0f
+        val endX = if (forward) -w * TapTurnTables.OVERSHOOT else w * (1f + TapTurnTables.OVERSHOOT)
+        val endY = h * TapTurnTables.END_Y_FRACTION
+        for (i in inFlight - 1 downTo 0) {
+            val slot = (first + i) % MAX_LEAVES
+            val fraction = ((now - leafStarts[slot]).toFloat() / LEAF_NANOS).coerceIn(0f, 1f)
+            val t = FastOutSlowInEasing.transform(fraction)
+            val ex = originX + (endX - originX) * t
+            val ey = h + (endY - h) * t
+            val frame = frames[slot]
+            // Same corner rule as the main draw pass
+            CurlMath.updateInto(frame, ex, ey, originX, if (ey < h / 2) 0f else h, w, h)
+            if (!frame.isVisible) continue
+
+            canvas.save()
+            canvas.clipPath(frame.flatPath)
+            val bmp = fallback.drawable(pages[leafPages[slot]], canvas)
+            if (bmp != null) {
+                canvas.drawBitmap(bmp, null, dst, leafPaint)
+            } else {
+                canvas.drawRect(dst, paperPaint)
+            }
+            canvas.restore()
+
+            if (!frame.shadowRegionPath.isEmpty) {
+                shadowPaint.shader = frame.castShadowGradient
+                canvas.save()
+                canvas.clipPath(frame.shadowRegionPath)
+                canvas.drawRect(0f, 0f, w, h, shadowPaint)
+                canvas.restore()
+                shadowPaint.shader = null
+            }
+        }
+    }
+
+    companion object {
+        /** Flight time of one leaf. */
+        const val LEAF_MILLIS = 250
+        private const val LEAF_NANOS = LEAF_MILLIS * 1_000_000L
+        /** Gap between leaves of a short run. */
+        const val STAGGER_MILLIS = 80L
+        /** Longest time the whole backlog takes to start. */
+        const val BACKLOG_MILLIS = 480L
+        /** Leaves in flight at once: LEAF_MILLIS over the shortest useful stagger, plus headroom. */
+        private const val MAX_LEAVES = 16
+    }
+}
@@ -0,0 +1,103 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.graphics.Path
+import android.graphics.Shader
+import androidx.compose.ui.graphics.drawscope.DrawScope
+import androidx.compose.ui.graphics.layer.GraphicsLayer
+import androidx.compose.ui.graphics.layer.drawLayer
+
+/**
+ * Clip-path drawer for composable pages: the same six layers as
+ * [CanvasCurlDrawer], with each page drawn from the [GraphicsLayer] its
+ * content was recorded into instead of from a bitmap.
+ *
+ * The layers are recorded at the leaf size, so they are drawn unscaled;
+ * the back face draws the current page's layer through
+ * [CurlFrame.backMatrix] like any other content. Honours the highlight and
+ * crease [StepDown] levels; there is no downsampled back face to fall
+ * back to.
+ */
+internal class LayerCurlDrawer {
+
+    private val backOverlayPaint = Paint(Paint.ANTI_ALIAS_FLAG).apply {
+        color = BACK_FACE_OVERLAY_COLOR
+        style = Paint.Style.FILL
+    }
+    private val shadowPaint = Paint(Paint.ANTI_ALIAS_FLAG)
+
+    /**
+     * @param scope    Draw scope whose canvas is [canvas].
+     * @param current  Layer of the page being turned.
+     * @param revealed Layer of the page underneath, if recorded.
+     * @param w        Leaf width.
+     * @param h        Leaf height.
+     */
+    fun draw(
+        scope: DrawScope,
+        canvas: Canvas,
+        frame: CurlFrame,
+        current: GraphicsLayer?,
+        revealed: GraphicsLayer?,
+        w: Float,
+        h: Float,
+        stepDown: Int
+    ) {
+        // Layer 1: Revealed page under the curl region
+        if (revealed != null) {
+            canvas.save()
+            canvas.clipPath(frame.backPath)
+            scope.drawLayer(revealed)
+            canvas.restore()
+        }
+
+        // Layer 2: Cast shadow on revealed page
+        if (!frame.shadowRegionPath.isEmpty) {
+            drawShadow(canvas, frame.shadowRegionPath, frame.castShadowGradient, w, h)
+        }
+
+        // Layer 3: Flat part of current page
+        if (current != null) {
+            canvas.save()
+            canvas.clipPath(frame.flatPath)
+            scope.drawLayer(current)
+            canvas.restore()
+        }
+
+        // Layer 4: Crease shadow on flat page
+        if (stepDown < StepDown.NO_CREASE && !frame.creaseRegionPath.isEmpty) {
+            drawShadow(canvas, frame.creaseRegionPath, frame.creaseShadowGradient, w, h)
+        }
+
+        // Layer 5: Back face, reflected across the fold, under the paper tint
+        if (!frame.backPath.isEmpty) {
+            if (current != null) {
+                canvas.save()
+                canvas.clipPath(frame.backPath)
+                canvas.concat(frame.backMatrix)
+                scope.drawLayer(current)
+                canvas.restore()
+
+                canvas.save()
+                canvas.clipPath(frame.backPath)
+                canvas.drawRect(0f, 0f, w, h, backOverlayPaint)
+                canvas.restore()
+            }
+
+            // Layer 6: Curl cylinder highlight
+            if (stepDown < StepDown.NO_HIGHLIGHT && !frame.curlStripPath.isEmpty) {
+                drawShadow(canvas, frame.curlStripPath, frame.curlHighlightGradient, w, h)
+            }
+        }
+    }
+
+    private fun drawShadow(canvas: Canvas, region: Path, gradient: Shader, w: Float, h: Float) {
+        shadowPaint.shader = gradient
+        canvas.save()
+        canvas.clipPath(region)
+        canvas.drawRect(0f, 0f, w, h, shadowPaint)
+        canvas.restore()
+        shadowPaint.shader = null
+    }
+}
@@ -0,0 +1,162 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.BitmapShader
+import android.graphics.Canvas
+import android.graphics.Matrix
+import android.graphics.Paint
+import android.graphics.RectF
+import android.graphics.Shader
+import android.os.Build
+import androidx.annotation.RequiresApi
+
+/**
+ * Mesh-based [CurlDrawer]: tessellates the frame with [CurlMesh] and issues
+ * five `drawVertices` calls (revealed, flat, shadows, back face, overlay)
+ * with no clip paths. Shading comes from per-vertex colors.
+ *
+ * When [BackFaceSource] supplies a downsampled, pre-tinted copy of the page
+ * the back face samples it and the overlay polygon is left out of the mesh;
+ * [StepDown] levels leave out the highlight and crease as well.
+ *
+ * Hardware-accelerated `drawVertices` needs API 29; [createCurlDrawer]
+ * only constructs this drawer there.
+ */
+@RequiresApi(Build.VERSION_CODES.Q)
+internal class MeshCurlDrawer(quality: CurlQuality = CurlQuality.HIGH) : CurlDrawer {
+
+    private val mesh = CurlMesh()
+    private val currentShader = PageShader()
+    private val revealedShader = PageShader()
+    private val backShader = PageShader()
+    private val backFace = BackFaceSource(quality)
+
+    private val texturePaint = Paint(Paint.FILTER_BITMAP_FLAG)
+    private val backFacePaint = Paint(Paint.FILTER_BITMAP_FLAG).apply {
+        alpha = BACK_FACE_CONTENT_ALPHA
+    }
+    private val colorPaint = Paint()
+
+    // Frame generation and options the mesh was last built with
+    private var builtGeneration = -1
+    private var builtWithOverlay = true
+    private var builtStepDown = StepDown.NONE
+
+    override fun draw(
+        canvas: Canvas,
+        frame: CurlFrame,
+        current: Bitmap?,
+        revealed: Bitmap?,
+        dst: RectF,
+        stepDown: Int
+    ) {
+        val lowRes = current?.let { backFace.get(it, stepDown) }
+        val withOverlay = lowRes == null
+        if (frame.generation != builtGeneration || withOverlay != builtWithOverlay || stepDown != builtStepDown) {
+            mesh.build(
+                frame, dst.width(), dst.height(),
+                backOverlay = withOverlay,
+                highlight = stepDown < StepDown.NO_HIGHLIGHT,
+                crease = stepDown < StepDown.NO_CREASE
+            )
+            builtGeneration = frame.generation
+            builtWithOverlay = withOverlay
+            builtStepDown = stepDown
+        }
+
+        if (revealed != null) {
+            texturePaint.shader = revealedShader.shaderFor(revealed, dst)
+            drawTextured(canvas, mesh.revealed, texturePaint)
+        }
+        if (current != null) {
+            texturePaint.shader = currentShader.shaderFor(current, dst)
+            drawTextured(canvas, mesh.front, texturePaint)
+        }
+        texturePaint.shader = null
+
+        // Cast and crease shadows sit on opposite sides of the fold, so they
+        // share one colored batch between the flat region and the back face
+        drawColored(canvas, mesh.shadows, colorPaint)
+
+        if (current != null) {
+            backFacePaint.shader = if (lowRes != null) {
+                backShader.shaderFor(lowRes, dst)
+            } else {
+                currentShader.shaderFor(current, dst)
+            }
+            drawTextured(canvas, mesh.back, backFacePaint)
+            backFacePaint.shader = null
+        }
+
+        drawColored(canvas, mesh.overlay, colorPaint)
+    }
+
+    override fun prepare(current: Bitmap) {
+        backFace.prepare(current)
+    }
+
+    override fun release() {
+        backFace.release()
+    }
+
+    override fun holds(bitmap: Bitmap): Boolean =
+        currentShader.holds(bitmap) || revealedShader.holds(bitmap) || backShader.holds(bitmap)
+}
+
+/** Draws a textured [batch]; per-vertex colors modulate the texture when [modulate] is set. */
+@RequiresApi(Build.VERSION_CODES.Q)
+internal fun drawTextured(canvas: Canvas, batch: MeshBatch, paint: Paint, modulate: Boolean = false) {
+    if (batch.isEmpty) return
+    canvas.drawVertices(
+        Canvas.VertexMode.TRIANGLES,
+        batch.vertexCount * 2, batch.verts, 0,
+        batch.texs, 0,
+        if (modulate) batch.colors else null, 0,
+        batch.indices, 0, batch.indexCount,
+        paint
+    )
+}
+
+/** Draws a [batch] filled with its per-vertex colors. */
+@RequiresApi(Build.VERSION_CODES.Q)
+internal fun drawColored(canvas: Canvas, batch: MeshBatch, paint: Paint) {
+    if (batch.isEmpty) return
+    canvas.drawVertices(
+        Canvas.VertexMode.TRIANGLES,
+        batch.vertexCount * 2, batch.verts, 0,
+        null, 0,
+        batch.colors, 0,
+        batch.indices, 0, batch.indexCount,
+        paint
+    )
+}
+
+/**
+ * BitmapShader for one page, mapping page coordinates onto the bitmap.
+ * Rebuilt only when the bitmap changes, so a drag reuses one shader.
+ */
+internal class PageShader {
+    private var bitmap: Bitmap? = null
+    private var shader: BitmapShader? = null
+    private val localMatrix = Matrix()
+    private val mappedDst = RectF()
+
+    fun holds(bmp: Bitmap): Boolean = bmp === bitmap
+
+    fun shaderFor(bmp: Bitmap, dst: RectF): BitmapShader {
+        var s = shader
+        if (s == null || bitmap !== bmp) {
+            s = BitmapShader(bmp, Shader.TileMode.CLAMP, Shader.TileMode.CLAMP)
+            shader = s
+            bitmap = bmp
+            mappedDst.setEmpty()
+        }
+        if (mappedDst != dst) {
+            localMatrix.setScale(dst.width() / bmp.width, dst.height() / bmp.height)
+            localMatrix.postTranslate(dst.left, dst.top)
+            s.setLocalMatrix(localMatrix)
+            mappedDst.set(dst)
+        }
+        return s
+    }
+}
@@ -0,0 +1,99 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Paint
+import android.graphics.RectF
+import androidx.compose.ui.graphics.drawscope.DrawScope
+import androidx.compose.ui.graphics.drawscope.drawIntoCanvas
+import androidx.compose.ui.graphics.layer.CompositingStrategy
+import androidx.compose.ui.graphics.layer.GraphicsLayer
+import androidx.compose.ui.graphics.layer.drawLayer
+import androidx.compose.ui.graphics.nativeCanvas
+
+/**
+ * The part of a curl frame that does not move: the background and the
+ * pages lying flat, recorded into an offscreen [GraphicsLayer].
+ *
+ * A curl frame composites the whole cached texture and then draws the
+ * curl layers only inside the fold's [CurlFrame.dirtyBounds], instead of
+ * clearing the canvas and redrawing the full revealed and current pages
+ * under clips. The base is still composited in full every frame; only the
+ * curl layers are bounded. The layer is
+ * re-recorded only when a page bitmap, its pixels, the size or the
+ * background change, so during a turn it is recorded once.
+ */
+internal class PageBase(private val layer: GraphicsLayer) {
+
+    private val paint = Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG)
+    private val dst = RectF()
+
+    // Inputs of the current recording
+    private var left: Bitmap? = null
+    private var leftGeneration = 0
+    private var right: Bitmap? = null
+    private var rightGeneration = 0
+    private var width = 0f
+    private var height = 0f
+    private var leafW = 0f
+    private var background = 0
+    private var recorded = false
+
+    init {
+        layer.compositingStrategy = CompositingStrategy.Offscreen
+    }
+
+    /**
+     * Draws [left] (and [right] beside it, in a spread) flat, each
+     * [leafW] wide, over [background].
+     */
+    fun draw(scope: DrawScope, left: Bitmap?, right: Bitmap?, leafW: Float, background: Int) {
+        val w = scope.size.width
+        val h = scope.size.height
+        if (!recorded || left !== this.left || right !== this.right ||
+            (left != null && left.generationId != leftGeneration) ||
+            (right != null && right.generationId != rightGeneration) ||
+            w != width || h != height || leafW != this.leafW || background != this.background
+        ) {
+            record(scope, left, right, leafW, background)
+        }
+        scope.drawLayer(layer)
+    }
+
+    /** Whether the recording draws [bitmap]. */
+    fun holds(bitmap: Bitmap): Boolean = recorded && (bitmap === left || bitmap === right)
+
+    /** Forgets the recorded pages so their bitmaps are not held. */
+    fun release() {
+        left = null
+        right = null
+        recorded = false
+    }
+
+    private fun record(scope: DrawScope, left: Bitmap?, right: Bitmap?, leafW: Float, background: Int) {
+        with(scope) {
+            layer.record {
+                drawIntoCanvas { canvas ->
+                    val nc = canvas.nativeCanvas
+                    nc.drawColor(background)
+                    left?.let {
+                        dst.set(0f, 0f, leafW, size.height)
+                        nc.drawBitmap(it, null, dst, paint)
+                    }
+                    right?.let {
+                        dst.set(leafW, 0f, leafW * 2f, size.height)
+                        nc.drawBitmap(it, null, dst, paint)
+                    }
+                }
+            }
+        }
+        this.left = left
+        leftGeneration = left?.generationId ?: 0
+        this.right = right
+        rightGeneration = right?.generationId ?: 0
+        width = scope.size.width
+        height = scope.size.height
+        this.leafW = leafW
+        this.background = background
+        recorded = true
+    }
+}
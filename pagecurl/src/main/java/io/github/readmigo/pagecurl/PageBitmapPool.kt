@@ -0,0 +1,112 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.BitmapFactory
+import android.util.LongSparseArray
+
+/**
+ * Pool of page-sized bitmaps recycled by [PageCurlContainer], keyed on
+ * width, height and config.
+ *
+ * When a pool is passed to the lazy container, bitmaps evicted from its
+ * page cache are returned here instead of being dropped (once nothing is
+ * drawing them any more), and
+ * [PageSource.loadPage] receives the pool so it can decode or render into
+ * a recycled bitmap. Steady-state page turns then allocate no new pixel
+ * memory; [hits] and [misses] confirm it.
+ *
+ * Only mutable, non-hardware bitmaps are pooled. Thread-safe.
+ *
+ * @param maxBytes Upper bound on pixel memory held by idle bitmaps.
+ */
+class PageBitmapPool(val maxBytes: Int = DEFAULT_MAX_BYTES) {
+
+    private val free = LongSparseArray<ArrayDeque<Bitmap>>()
+    private var pooledBytes = 0
+
+    /** Requests answered with a recycled bitmap. */
+    var hits = 0
+        @Synchronized get
+        private set
+
+    /** Requests that found no matching bitmap. */
+    var misses = 0
+        @Synchronized get
+        private set
+
+    /** Bytes currently held by idle bitmaps. */
+    val sizeBytes: Int
+        @Synchronized get() = pooledBytes
+
+    /** Takes a recycled bitmap of exactly this size and config, or null on a miss. */
+    @Synchronized
+    fun acquire(width: Int, height: Int, config: Bitmap.Config): Bitmap? {
+        val bitmap = free.get(key(width, height, config))?.removeLastOrNull()
+        if (bitmap == null) {
+            misses++
+            return null
+        }
+        hits++
+        pooledBytes -= bitmap.allocationByteCount
+        return bitmap
+    }
+
+    /** A recycled bitmap if one matches, else a newly allocated one. Contents are undefined. */
+    fun get(width: Int, height: Int, config: Bitmap.Config): Bitmap =
+        acquire(width, height, config) ?: Bitmap.createBitmap(width, height, config)
+
+    /**
+     * Prepares [options] to decode a [width] x [height] image into a
+     * recycled bitmap via [BitmapFactory.Options.inBitmap], when one is
+     * available. Returns [options] for chaining.
+     */
+    fun configure(
+        options: BitmapFactory.Options,
+        width: Int,
+        height: Int,
+        config: Bitmap.Config = Bitmap.Config.ARGB_8888
+    ): BitmapFactory.Options {
+        options.inMutable = true
+        options.inPreferredConfig = config
+        options.inBitmap = acquire(width, height, config)
+        return options
+    }
+
+    /**
+     * Returns [bitmap] to the pool. The caller must no longer draw or hold
+     * it. Hardware, immutable and recycled bitmaps are ignored, as are
+     * bitmaps that would exceed [maxBytes].
+     */
+    @Synchronized
+    fun put(bitmap: Bitmap) {
+        val config = bitmap.config ?: return
+        if (bitmap.isRecycled || !bitmap.isMutable || config == Bitmap.Config.HARDWARE) return
+        val bytes = bitmap.allocationByteCount
+        if (pooledBytes + bytes > maxBytes) return
+        val key = key(bitmap.width, bitmap.height, config)
+        val queue = free.get(key) ?: ArrayDeque<Bitmap>().also { free.put(key, it) }
+        queue.addLast(bitmap)
+        pooledBytes += bytes
+    }
+
+    /** Drops every idle bitmap. */
+    @Synchronized
+    fun clear() {
+        free.clear()
+        pooledBytes = 0
+    }
+
+    @Synchronized
+    fun resetCounters() {
+        hits = 0
+        misses = 0
+    }
+
+    private fun key(width: Int, height: Int, config: Bitmap.Config): Long =
+        (width.toLong() shl 40) or (height.toLong() shl 16) or config.ordinal.toLong()
+
+    companion object {
+        /** Room for about four 1080x2400 ARGB_8888 pages. */
+        const val DEFAULT_MAX_BYTES = 40 * 1024 * 1024
+    }
+}
@@ -0,0 +1,374 @@
+package io.github.readmigo.pagecurl
+
+import android.content.ComponentCallbacks2
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.util.Log
+import android.util.LruCache
+import androidx.compose.runtime.mutableIntStateOf
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.Job
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
+import kotlin.math.abs
+
+private const val TAG = "PageCurl"
+
+/**
+ * [PageProvider] over a [PageSource] with a prefetch window and a
+ * byte-bounded LRU of decoded pages.
+ *
+ * Loads run on [loadDispatcher] in jobs owned by [scope] (the container's
+ * main-thread scope), so results are inserted on the main thread between
+ * frames and the draw pass never waits. While a page is missing, [get]
+ * falls back to a low-res copy kept from an earlier load, or to
+ * [PageSource.placeholder].
+ *
+ * With a [pool], evicted pages and placeholders are recycled into it and
+ * loads draw from it, so steady-state turns reuse pixel memory. An evicted
+ * bitmap may still be referenced by a recorded layer or by the frame the
+ * render thread is drawing, and a decode into it would tear that frame,
+ * so it is only handed to the pool by [recycleRetired] once no recording
+ * holds it and a full frame has gone by without it. Converted pages (see
+ * [PageFormat]) are immutable and are never pooled; only their decoded
+ * originals are.
+ *
+ * Loaded pages are converted to [format] (placeholders are taken from the
+ * original first, since hardware bitmaps cannot be read back cheaply).
+ *
+ * Changes announced through [invalidate] only touch the pages in the
+ * changed range, and inserts and evictions only invalidate the draw pass
+ * when the page is within [NEAR_PAGES] of the current one.
+ *
+ * Under memory pressure ([trimMemory]) the window shrinks to the current
+ * page's neighbours, and at `TRIM_MEMORY_RUNNING_CRITICAL` to the visible
+ * pages and the ones the next turn in the reading direction reveals (a
+ * spread's worth of each in two-page mode); pages outside it are dropped
+ * at once. The full window comes back after [RELAX_TURNS] turns without
+ * further pressure.
+ */
+internal class PageCache(
+    private val source: PageSource,
+    private val prefetch: PagePrefetch,
+    private val pool: PageBitmapPool?,
+    private val format: PageFormat,
+    private val lowRamDevice: Boolean,
+    private val scope: CoroutineScope,
+    private val loadDispatcher: CoroutineDispatcher = Dispatchers.Default
+) : PageProvider {
+
+    // Bumped on every insert/evict near the current page so draw passes that
+    // read the cache re-run
+    private val revision = mutableIntStateOf(0)
+    // Bumped when the source reports a new page count
+    private val countRevision = mutableIntStateOf(0)
+    private var knownCount = source.pageCount
+
+    private val pages = object : LruCache<Int, Bitmap>(prefetch.maxCacheBytes) {
+        override fun sizeOf(key: Int, value: Bitmap) = value.allocationByteCount
+
+        override fun entryRemoved(evicted: Boolean, key: Int, oldValue: Bitmap, newValue: Bitmap?) {
+            if (oldValue !== newValue) {
+                source.release(key)
+                retire(oldValue)
+                touch(key)
+            }
+        }
+    }
+
+    private val thumbnails = object : LruCache<Int, Bitmap>(prefetch.maxCacheBytes / 16) {
+        override fun sizeOf(key: Int, value: Bitmap) = value.allocationByteCount
+
+        override fun entryRemoved(evicted: Boolean, key: Int, oldValue: Bitmap, newValue: Bitmap?) {
+            if (oldValue !== newValue) retire(oldValue)
+        }
+    }
+
+    // Evicted bitmaps on their way to the pool: still held by a recording,
+    // or no longer held but possibly drawn by the frame in flight
+    private val retired = ArrayList<Bitmap>()
+    private val cooling = ArrayList<Bitmap>()
+    private var retiredBytes = 0L
+
+    // Read-only once built, so concurrent loads can share it
+    private val thumbnailPaint = Paint(Paint.FILTER_BITMAP_FLAG)
+
+    private val jobs = HashMap<Int, Job>()
+    private var lastCurrent = -1
+    // Last page prepared as shown rather than warmed; turns count from it
+    private var lastShown = -1
+    // Pages shown at lastCurrent: 1, or 2 in a spread
+    private var lastStep = 1
+    private var forward = true
+
+    // Residency under memory pressure: RESIDENCY_FULL, _NEIGHBOURS or _REVEALED
+    private var residency = RESIDENCY_FULL
+    private var turnsSinceTrim = 0
+    // Pages kept past the visible ones in, and against, the reading
+    // direction; a neighbour is a whole spread in two-page mode
+    private val keptAhead: Int
+        get() = when (residency) {
+            RESIDENCY_FULL -> prefetch.ahead
+            RESIDENCY_NEIGHBOURS -> prefetch.ahead.coerceAtMost(lastStep)
+            else -> lastStep
+        }
+    private val keptBehind: Int
+        get() = when (residency) {
+            RESIDENCY_FULL -> prefetch.behind
+            RESIDENCY_NEIGHBOURS -> prefetch.behind.coerceAtMost(lastStep)
+            else -> 0
+        }
+
+    override val pageCount: Int
+        get() {
+            countRevision.intValue // observe growth reported through invalidate
+            return source.pageCount
+        }
+
+    override fun get(index: Int): Bitmap? {
+        revision.intValue // observe inserts and evictions
+        if (index !in 0 until pageCount) return null
+        return pages.get(index) ?: thumbnails.get(index) ?: source.placeholder(index)
+    }
+
+    override val residentBytes: Long
+        get() = pages.size().toLong() + thumbnails.size()
+
+    override fun prepare(current: Int, step: Int, warm: Boolean) {
+        if (lastCurrent >= 0 && current != lastCurrent) forward = current > lastCurrent
+        // Only pages actually shown are turns; warming a jump's target is not
+        if (!warm) {
+            if (lastShown >= 0 && current != lastShown &&
+                residency != RESIDENCY_FULL && ++turnsSinceTrim >= RELAX_TURNS
+            ) {
+                residency--
+                turnsSinceTrim = 0
+                Log.d(TAG, "residency relaxed to $residency")
+            }
+            lastShown = current
+        }
+        lastCurrent = current
+        lastStep = step
+
+        val window = window(current)
+        val first = window.first
+        val last = window.last
+
+        // Pending loads that fell out of the window are no longer worth finishing
+        val iterator = jobs.entries.iterator()
+        while (iterator.hasNext()) {
+            val (index, job) = iterator.next()
+            if (index < first || index > last) {
+                job.cancel()
+                iterator.remove()
+            }
+        }
+
+        // Priority: the visible pages, the neighbour the next turn reveals,
+        // the other neighbour, then outward in the reading direction
+        val end = current + step - 1
+        val ahead = keptAhead
+        val behind = keptBehind
+        for (index in current..end) load(index)
+        for (distance in 1..maxOf(ahead, behind)) {
+            if (distance <= ahead) load(if (forward) end + distance else current - distance)
+            if (distance <= behind) load(if (forward) current - distance else end + distance)
+        }
+
+        // Refresh recency so window pages are the last to be evicted
+        for (index in last downTo first) pages.get(index)
+        pages.get(current)
+    }
+
+    /**
+     * Applies a change to the pages in [changed]: loads that may have read
+     * the old content are restarted, cached pages in the prefetch window are
+     * reloaded (the stale copy stays drawn until the new one arrives) and
+     * the rest are dropped. Pages past the end of a shrunk book are dropped.
+     */
+    fun invalidate(changed: IntRange) {
+        val count = source.pageCount
+        if (count != knownCount) {
+            knownCount = count
+            countRevision.intValue++
+        }
+        val window = if (lastCurrent >= 0) window(lastCurrent) else IntRange.EMPTY
+        val iterator = jobs.entries.iterator()
+        while (iterator.hasNext()) {
+            val (index, job) = iterator.next()
+            if (index in changed) {
+                job.cancel()
+                iterator.remove()
+            }
+        }
+        for (index in thumbnails.snapshot().keys) {
+            if (index in changed || index >= count) thumbnails.remove(index)
+        }
+        for (index in pages.snapshot().keys) {
+            when {
+                index >= count || (index in changed && index !in window) -> pages.remove(index)
+                index in changed -> load(index, reload = true)
+            }
+        }
+        // Pages appended inside the window
+        if (lastCurrent >= 0 && count > 0) prepare(lastCurrent.coerceAtMost(count - 1), lastStep, warm = true)
+        Log.d(TAG, "invalidate: $changed, pageCount=$count")
+    }
+
+    /**
+     * Shrinks the window for a `ComponentCallbacks2` trim [level] and drops
+     * the cached pages and pending loads outside it. From
+     * `TRIM_MEMORY_RUNNING_LOW` the placeholders and the pool go too.
+     * `TRIM_MEMORY_UI_HIDDEN` alone changes nothing, since the book is
+     * likely to come straight back.
+     */
+    override fun trimMemory(level: Int) {
+        val target = when {
+            level >= ComponentCallbacks2.TRIM_MEMORY_BACKGROUND -> RESIDENCY_REVEALED
+            level >= ComponentCallbacks2.TRIM_MEMORY_UI_HIDDEN -> return
+            level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL -> RESIDENCY_REVEALED
+            level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_MODERATE -> RESIDENCY_NEIGHBOURS
+            else -> return
+        }
+        // Pressure only tightens the window; RELAX_TURNS turns loosen it
+        residency = maxOf(residency, target)
+        turnsSinceTrim = 0
+        if (lastCurrent >= 0) {
+            val window = window(lastCurrent)
+            for (index in pages.snapshot().keys) {
+                if (index !in window) pages.remove(index)
+            }
+            prepare(lastCurrent, lastStep, warm = true)
+        }
+        // After the evictions, which retire into the pool
+        if (level >= ComponentCallbacks2.TRIM_MEMORY_RUNNING_LOW) {
+            thumbnails.evictAll()
+            dropRetired()
+            pool?.clear()
+        }
+        Log.d(TAG, "trimMemory: level=$level, residency=$residency, residentBytes=$residentBytes")
+    }
+
+    /** Cancels pending loads and releases every cached page. */
+    fun releaseAll() {
+        for (job in jobs.values) job.cancel()
+        jobs.clear()
+        pages.evictAll()
+        thumbnails.evictAll()
+        // The last frame may still be drawing them; leave them to the GC
+        dropRetired()
+    }
+
+    /**
+     * Hands retired bitmaps to the pool in two steps, one draw pass apart:
+     * the ones no recording [held] any more stop being drawn with this
+     * pass, and by the next one the render thread has finished the last
+     * frame that could have drawn them.
+     */
+    override fun recycleRetired(held: (Bitmap) -> Boolean) {
+        val pool = pool ?: return
+        for (i in cooling.indices) {
+            val bitmap = cooling[i]
+            retiredBytes -= bitmap.allocationByteCount
+            pool.put(bitmap)
+        }
+        cooling.clear()
+        var kept = 0
+        for (i in retired.indices) {
+            val bitmap = retired[i]
+            if (held(bitmap)) retired[kept++] = bitmap else cooling.add(bitmap)
+        }
+        while (retired.size > kept) retired.removeAt(retired.size - 1)
+    }
+
+    private fun retire(bitmap: Bitmap) {
+        val pool = pool ?: return
+        // The pool would reject these anyway: converted copies are immutable
+        if (!bitmap.isMutable || bitmap.config == Bitmap.Config.HARDWARE) return
+        // Past the pool's budget, leave them to the GC too
+        val bytes = bitmap.allocationByteCount
+        if (retiredBytes + bytes > pool.maxBytes) return
+        retired.add(bitmap)
+        retiredBytes += bytes
+    }
+
+    private fun dropRetired() {
+        retired.clear()
+        cooling.clear()
+        retiredBytes = 0L
+    }
+
+    // The visible pages at current plus the kept pages either side
+    private fun window(current: Int): IntRange {
+        val before = if (forward) keptBehind else keptAhead
+        val after = if (forward) keptAhead else keptBehind
+        return (current - before).coerceAtLeast(0)..(current + lastStep - 1 + after).coerceAtMost(pageCount - 1)
+    }
+
+    // Only pages the draw pass can reach need to invalidate it
+    private fun touch(index: Int) {
+        if (lastCurrent < 0 || abs(index - lastCurrent) <= NEAR_PAGES) revision.intValue++
+    }
+
+    private fun load(index: Int, reload: Boolean = false) {
+        if (index !in 0 until pageCount || jobs.containsKey(index)) return
+        if (!reload && pages.get(index) != null) return
+        jobs[index] = scope.launch {
+            try {
+                val bitmap = withContext(loadDispatcher) {
+                    if (pool != null) source.loadPage(index, pool) else source.loadPage(index)
+                }
+                val (page, thumbnail) = withContext(loadDispatcher) {
+                    val thumbnail = makeThumbnail(bitmap)
+                    val page = format.convert(bitmap, lowRamDevice)
+                    if (page !== bitmap) pool?.put(bitmap)
+                    page to thumbnail
+                }
+                pages.put(index, page)
+                if (thumbnail != null) thumbnails.put(index, thumbnail)
+                touch(index)
+            } finally {
+                // A cancelled job may already have been replaced by a newer one
+                if (jobs[index] === coroutineContext[Job]) jobs.remove(index)
+            }
+        }
+    }
+
+    private fun makeThumbnail(bitmap: Bitmap): Bitmap? {
+        val scale = prefetch.placeholderScale
+        if (scale <= 1 || bitmap.config == Bitmap.Config.HARDWARE) return null
+        val width = (bitmap.width / scale).coerceAtLeast(1)
+        val height = (bitmap.height / scale).coerceAtLeast(1)
+        return try {
+            if (pool == null) {
+                Bitmap.createScaledBitmap(bitmap, width, height, true)
+            } else {
+                pool.get(width, height, Bitmap.Config.ARGB_8888).also { thumb ->
+                    Canvas(thumb).apply {
+                        scale(width / bitmap.width.toFloat(), height / bitmap.height.toFloat())
+                        drawBitmap(bitmap, 0f, 0f, thumbnailPaint)
+                    }
+                }
+            }
+        } catch (e: OutOfMemoryError) {
+            Log.w(TAG, "placeholder skipped: ${e.message}")
+            null
+        }
+    }
+
+    private companion object {
+        /** Pages either side of the current one that the draw pass can reach (a spread and its neighbours). */
+        const val NEAR_PAGES = 3
+
+        const val RESIDENCY_FULL = 0
+        /** At most one page either side of the current one. */
+        const val RESIDENCY_NEIGHBOURS = 1
+        /** The current page and the one the next turn reveals. */
+        const val RESIDENCY_REVEALED = 2
+        /** Turns after the last trim before the window grows back one step. */
+        const val RELAX_TURNS = 8
+    }
+}
@@ -1,46 +1,68 @@
 package io.github.readmigo.pagecurl
 
+import android.app.Activity
+import android.content.ComponentCallbacks2
+import android.content.Context
+import android.content.ContextWrapper
+import android.content.res.Configuration
 import android.graphics.Bitmap
 import android.graphics.Paint
-import android.graphics.PointF
 import android.graphics.RectF
+import android.os.Build
+import android.os.PowerManager
 import android.util.Log
-import androidx.compose.animation.core.Animatable
-import androidx.compose.animation.core.FastOutSlowInEasing
-import androidx.compose.animation.core.Spring
-import androidx.compose.animation.core.spring
-import androidx.compose.animation.core.tween
 import androidx.compose.foundation.gestures.detectDragGestures
 import androidx.compose.foundation.gestures.detectTapGestures
+import androidx.compose.foundation.layout.Box
+import androidx.compose.foundation.layout.fillMaxHeight
 import androidx.compose.foundation.layout.fillMaxSize
+import androidx.compose.foundation.layout.fillMaxWidth
 import androidx.compose.runtime.Composable
+import androidx.compose.runtime.DisposableEffect
 import androidx.compose.runtime.LaunchedEffect
+import androidx.compose.runtime.SideEffect
 import androidx.compose.runtime.getValue
+import androidx.compose.runtime.key
 import androidx.compose.runtime.mutableFloatStateOf
 import androidx.compose.runtime.mutableIntStateOf
+import androidx.compose.runtime.mutableStateMapOf
 import androidx.compose.runtime.mutableStateOf
 import androidx.compose.runtime.remember
 import androidx.compose.runtime.rememberCoroutineScope
+import androidx.compose.runtime.rememberUpdatedState
 import androidx.compose.runtime.setValue
+import androidx.compose.runtime.snapshotFlow
+import androidx.compose.runtime.withFrameNanos
+import androidx.compose.ui.ExperimentalComposeUiApi
 import androidx.compose.ui.Modifier
+import androidx.compose.ui.draw.drawWithContent
 import androidx.compose.ui.graphics.Color
 import androidx.compose.ui.graphics.drawscope.drawIntoCanvas
+import androidx.compose.ui.graphics.drawscope.translate
+import androidx.compose.ui.graphics.layer.GraphicsLayer
+import androidx.compose.ui.graphics.layer.drawLayer
 import androidx.compose.ui.graphics.nativeCanvas
+import androidx.compose.ui.graphics.rememberGraphicsLayer
 import androidx.compose.ui.graphics.toArgb
+import androidx.compose.ui.input.pointer.motionEventSpy
 import androidx.compose.ui.input.pointer.pointerInput
 import androidx.compose.ui.input.pointer.util.VelocityTracker
+import androidx.compose.ui.input.pointer.util.addPointerInputChange
 import androidx.compose.ui.layout.onSizeChanged
+import androidx.compose.ui.platform.LocalContext
+import androidx.compose.ui.platform.LocalDensity
+import androidx.compose.ui.platform.LocalView
+import androidx.metrics.performance.JankStats
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.first
 import kotlinx.coroutines.launch
 import kotlin.math.abs
 
 private const val TAG = "PageCurl"
 private const val COMPLETION_THRESHOLD = 0.35f
 private const val VELOCITY_THRESHOLD = 500f
-
-// Back-face rendering: opacity of the mirrored page content (0-255)
-private const val BACK_FACE_CONTENT_ALPHA = 255
-// Back-face rendering: semi-transparent white overlay for paper-back look
-private const val BACK_FACE_OVERLAY_ALPHA = 90
+private const val HOLD_REPEAT_MILLIS = 100L
 
 /**
  * A realistic Canvas-based page-curl container for Jetpack Compose.
@@ -49,13 +71,41 @@ private const val BACK_FACE_OVERLAY_ALPHA = 90
  * handling, and curl animation are handled internally using Android Canvas
  * with bezier fold-line geometry.
  *
- * @param pages           Pre-rendered page bitmaps.
+ * @param pages           Pre-rendered page bitmaps. May be a snapshot state list
+ *                        (`mutableStateListOf`) that grows while shown; the
+ *                        position and any curl in progress are kept.
  * @param backgroundColor Background color shown when no page is drawn.
  * @param startFromLastPage Open at the last page instead of the first.
  * @param onPageChanged   Invoked (1-based currentPage, totalPages) after every turn.
  * @param onReachStart    Invoked when the user tries to go before page 1.
  * @param onReachEnd      Invoked when the user tries to go past the last page.
  * @param onTap           Invoked on a tap in the centre third of the screen.
+ * @param renderer        Rendering backend for curl frames; see [CurlRenderer].
+ * @param metrics         Optional listener for per-turn frame timings; see
+ *                        [PageCurlMetrics]. Null takes no measurements.
+ * @param nativeGeometry  Precompute the geometry of animated turns in one
+ *                        native (NEON) pass instead of per frame in Kotlin.
+ *                        Ignored where the native library cannot load.
+ * @param cachePageLayers Record the page composites into offscreen layers so a
+ *                        curl only re-clips and re-transforms them; pages are
+ *                        scaled into place once per turn. Canvas renderer,
+ *                        API 29+; costs one page-sized texture per layer.
+ * @param quality         Back-face and shadow fidelity; see [CurlQuality].
+ *                        [CurlQuality.AUTO] picks BALANCED on low-RAM devices.
+ * @param adaptiveQuality Give up the highlight, then the crease shadow, then the
+ *                        full-resolution back face for the rest of a turn when
+ *                        a drag keeps missing frames, starting lower when the
+ *                        device is thermally throttled. Restored after the turn.
+ * @param spread          One page or a two-page spread; see [PageSpread]. In a
+ *                        spread [currentPage][onPageChanged] is the left page.
+ * @param predictTouch    Draw a dragged corner where the finger is predicted to
+ *                        be at the next frame (androidx.input motion
+ *                        prediction), hiding about a frame of touch latency.
+ * @param state           Hoisted page state for reading the current page and
+ *                        jumping to another; see [rememberPageCurlState]. It
+ *                        keeps its page when the page list changes. With a
+ *                        state the book opens at its page and
+ *                        [startFromLastPage] is ignored.
  */
 @Composable
 fun PageCurlContainer(
@@ -66,32 +116,343 @@ fun PageCurlContainer(
     onPageChanged: (currentPage: Int, totalPages: Int) -> Unit = { _, _ -> },
     onReachStart: () -> Unit = {},
     onReachEnd: () -> Unit = {},
-    onTap: () -> Unit = {}
+    onTap: () -> Unit = {},
+    renderer: CurlRenderer = CurlRenderer.Canvas,
+    metrics: PageCurlMetrics? = null,
+    nativeGeometry: Boolean = false,
+    cachePageLayers: Boolean = false,
+    quality: CurlQuality = CurlQuality.AUTO,
+    adaptiveQuality: Boolean = true,
+    spread: PageSpread = PageSpread.SINGLE,
+    predictTouch: Boolean = true,
+    state: PageCurlState? = null
+) {
+    val provider = remember(pages) { ListPageProvider(pages) }
+    PageCurlContent(
+        provider = provider,
+        backgroundColor = backgroundColor,
+        modifier = modifier,
+        startFromLastPage = startFromLastPage,
+        onPageChanged = onPageChanged,
+        onReachStart = onReachStart,
+        onReachEnd = onReachEnd,
+        onTap = onTap,
+        renderer = renderer,
+        metrics = metrics,
+        nativeGeometry = nativeGeometry,
+        cachePageLayers = cachePageLayers,
+        quality = quality,
+        adaptiveQuality = adaptiveQuality,
+        spread = spread,
+        predictTouch = predictTouch,
+        state = state
+    )
+}
+
+/**
+ * Page-curl container that loads pages lazily from a [PageSource].
+ *
+ * Pages are loaded on a background dispatcher into a byte-bounded LRU,
+ * keeping a window around the current page that is biased toward the
+ * direction of the last turn (see [PagePrefetch]). Evicted pages are handed
+ * back through [PageSource.release]. A page that has not loaded yet is
+ * drawn from a low-res placeholder when one is available, otherwise as
+ * [backgroundColor]; the draw pass never waits for a load.
+ *
+ * The source may grow or change while shown; changes announced through
+ * [PageSource.invalidations] reload only the affected pages, without
+ * resetting the position or interrupting a curl.
+ *
+ * @param pageSource      Supplies page bitmaps on demand.
+ * @param prefetch        Prefetch window and cache budget.
+ * @param bitmapPool      Optional pool that evicted pages are recycled into and
+ *                        that [PageSource.loadPage] can draw from.
+ * @param pageFormat      Pixel format loaded pages are converted to; see [PageFormat].
+ * @see PageCurlContainer for the remaining parameters.
+ */
+@Composable
+fun PageCurlContainer(
+    pageSource: PageSource,
+    backgroundColor: Color = Color.White,
+    modifier: Modifier = Modifier,
+    startFromLastPage: Boolean = false,
+    onPageChanged: (currentPage: Int, totalPages: Int) -> Unit = { _, _ -> },
+    onReachStart: () -> Unit = {},
+    onReachEnd: () -> Unit = {},
+    onTap: () -> Unit = {},
+    renderer: CurlRenderer = CurlRenderer.Canvas,
+    metrics: PageCurlMetrics? = null,
+    nativeGeometry: Boolean = false,
+    cachePageLayers: Boolean = false,
+    quality: CurlQuality = CurlQuality.AUTO,
+    adaptiveQuality: Boolean = true,
+    spread: PageSpread = PageSpread.SINGLE,
+    predictTouch: Boolean = true,
+    state: PageCurlState? = null,
+    prefetch: PagePrefetch = PagePrefetch(),
+    bitmapPool: PageBitmapPool? = null,
+    pageFormat: PageFormat = PageFormat.ORIGINAL
 ) {
-    val scope = rememberCoroutineScope()
-    val pageCount = pages.size
+    val loadScope = rememberCoroutineScope()
+    val context = LocalContext.current
+    val cache = remember(pageSource, prefetch, bitmapPool, pageFormat) {
+        PageCache(
+            pageSource, prefetch, bitmapPool, pageFormat,
+            lowRamDevice = isLowRamDevice(context),
+            scope = loadScope
+        )
+    }
+    DisposableEffect(cache) {
+        onDispose { cache.releaseAll() }
+    }
+    LaunchedEffect(cache) {
+        pageSource.invalidations.collect { cache.invalidate(it) }
+    }
+    PageCurlContent(
+        provider = cache,
+        backgroundColor = backgroundColor,
+        modifier = modifier,
+        startFromLastPage = startFromLastPage,
+        onPageChanged = onPageChanged,
+        onReachStart = onReachStart,
+        onReachEnd = onReachEnd,
+        onTap = onTap,
+        renderer = renderer,
+        metrics = metrics,
+        nativeGeometry = nativeGeometry,
+        cachePageLayers = cachePageLayers,
+        quality = quality,
+        adaptiveQuality = adaptiveQuality,
+        spread = spread,
+        predictTouch = predictTouch,
+        state = state
+    )
+}
+
+/**
+ * Page-curl container over composable pages.
+ *
+ * Each page near the current one is composed into a hidden slot whose
+ * drawing is recorded into a [GraphicsLayer]; every curl layer (flat page,
+ * revealed page and the reflected back face) draws from those recordings,
+ * so pages are never rasterized into bitmaps. Only the pages around the
+ * current one are composed: the previous, current and next page, or the
+ * neighbouring spreads in [PageSpread.DOUBLE]. Composed pages keep
+ * recomposing and re-recording as their state changes.
+ *
+ * Pages are drawn with the clip-path renderer; the mesh renderers need a
+ * bitmap to texture from. Slots receive no input, since the container
+ * handles all gestures.
+ *
+ * @param pageCount   Number of pages.
+ * @param pageContent Content of the page at a 0-based index, laid out at
+ *                    the page (or leaf) size.
+ * @see PageCurlContainer for the remaining parameters.
+ */
+@Composable
+fun PageCurlContainer(
+    pageCount: Int,
+    backgroundColor: Color = Color.White,
+    modifier: Modifier = Modifier,
+    startFromLastPage: Boolean = false,
+    onPageChanged: (currentPage: Int, totalPages: Int) -> Unit = { _, _ -> },
+    onReachStart: () -> Unit = {},
+    onReachEnd: () -> Unit = {},
+    onTap: () -> Unit = {},
+    metrics: PageCurlMetrics? = null,
+    nativeGeometry: Boolean = false,
+    adaptiveQuality: Boolean = true,
+    spread: PageSpread = PageSpread.SINGLE,
+    predictTouch: Boolean = true,
+    state: PageCurlState? = null,
+    pageContent: @Composable (index: Int) -> Unit
+) {
+    val provider = remember(pageCount) { ContentPageProvider(pageCount) }
+    PageCurlContent(
+        provider = provider,
+        backgroundColor = backgroundColor,
+        modifier = modifier,
+        startFromLastPage = startFromLastPage,
+        onPageChanged = onPageChanged,
+        onReachStart = onReachStart,
+        onReachEnd = onReachEnd,
+        onTap = onTap,
+        renderer = CurlRenderer.Canvas,
+        metrics = metrics,
+        nativeGeometry = nativeGeometry,
+        cachePageLayers = false,
+        quality = CurlQuality.HIGH,
+        adaptiveQuality = adaptiveQuality,
+        spread = spread,
+        predictTouch = predictTouch,
+        state = state,
+        pageContent = pageContent
+    )
+}
+
+@OptIn(ExperimentalComposeUiApi::class)
+@Composable
+private fun PageCurlContent(
+    provider: PageProvider,
+    backgroundColor: Color,
+    modifier: Modifier,
+    startFromLastPage: Boolean,
+    onPageChanged: (currentPage: Int, totalPages: Int) -> Unit,
+    onReachStart: () -> Unit,
+    onReachEnd: () -> Unit,
+    onTap: () -> Unit,
+    renderer: CurlRenderer,
+    metrics: PageCurlMetrics?,
+    nativeGeometry: Boolean,
+    cachePageLayers: Boolean,
+    quality: CurlQuality,
+    adaptiveQuality: Boolean,
+    spread: PageSpread,
+    predictTouch: Boolean,
+    state: PageCurlState?,
+    pageContent: (@Composable (index: Int) -> Unit)? = null
+) {
+    // The book is read through state so the gesture detectors, effects and
+    // draw pass see appended or replaced pages without being restarted
+    val pages by rememberUpdatedState(provider)
+    val pageCount by rememberUpdatedState(provider.pageCount)
     val bgArgb = backgroundColor.toArgb()
 
-    var currentPage by remember(pageCount, startFromLastPage) {
+    // Without a hoisted state the position survives page-list changes; it
+    // is only re-initialised once the first pages arrive
+    val pageState = state ?: remember(startFromLastPage, pageCount > 0) {
         val initial = if (startFromLastPage && pageCount > 0) pageCount - 1 else 0
         Log.d(TAG, "init: pageCount=$pageCount, startFromLastPage=$startFromLastPage, initialPage=$initial")
-        mutableIntStateOf(initial)
+        PageCurlState(initial)
+    }
+    var currentPage by pageState::currentPage
+    // Keep the state in step with the book, clamping if it shrank
+    SideEffect {
+        pageState.pageCount = pageCount
+        if (pageCount > 0 && currentPage > pageCount - 1) currentPage = pageCount - 1
+    }
+
+    // ---- First frame ----
+    // A bitmap book opens on a plain draw of its first page; the gestures,
+    // turn engines and renderer below are set up the frame after. A lazy
+    // source starts loading the opening page right away, so it is not held
+    // up by the deferral (an AUTO spread is resolved once measured).
+    var started by remember { mutableStateOf(pageContent != null) }
+    if (!started) {
+        val opening = currentPage.coerceAtMost(pageCount - 1)
+        FirstPage(pages, opening, spread, bgArgb, modifier)
+        LaunchedEffect(Unit) {
+            if (opening >= 0) {
+                if (spread == PageSpread.DOUBLE) pages.prepare(opening - opening % 2, 2) else pages.prepare(opening)
+            }
+            withFrameNanos { }
+            started = true
+        }
+        return
     }
 
     // Page dimensions (in pixels)
     var pageW by remember { mutableFloatStateOf(0f) }
     var pageH by remember { mutableFloatStateOf(0f) }
+    // Two-page spread: pages advance in pairs and the turning leaf is half as wide
+    var twoUp by remember { mutableStateOf(false) }
+    fun pageStep() = if (twoUp) 2 else 1
 
     // ---- Curl state ----
-    // The position of the page corner being dragged (null = no curl active)
-    var dragCorner by remember { mutableStateOf<PointF?>(null) }
+    // Primitive state read only by the draw lambda, so a drag or animation
+    // frame invalidates the draw pass without recomposing.
+    // The position of the page corner being dragged (valid while curlActive)
+    var curlActive by remember { mutableStateOf(false) }
+    var dragX by remember { mutableFloatStateOf(0f) }
+    var dragY by remember { mutableFloatStateOf(0f) }
     var curlForward by remember { mutableStateOf(true) }
 
-    // Animation state
-    val animProgress = remember { Animatable(0f) }
-    var animStartPt by remember { mutableStateOf(PointF(0f, 0f)) }
-    var animEndPt by remember { mutableStateOf(PointF(0f, 0f)) }
-    var isAnimCompleting by remember { mutableStateOf(false) }
+    // Animated turns: one engine for the container's lifetime, plus the
+    // batched animation that runs of queued turns collapse into
+    val turns = remember { TurnEngine() }
+    val flip = remember { FastFlip() }
+    // Keyframes of the two fixed tap-turn paths, rebuilt on size change;
+    // tapTurn is the table driving the running animation, if any
+    val tapTables = remember { TapTurnTables() }
+    var tapTurn by remember { mutableStateOf<CurlTrajectory?>(null) }
+
+    // The gesture detectors outlive recompositions, so they read the
+    // latest callbacks through these rather than capturing stale ones.
+    val currentOnReachStart by rememberUpdatedState(onReachStart)
+    val currentOnReachEnd by rememberUpdatedState(onReachEnd)
+    val currentOnTap by rememberUpdatedState(onTap)
+
+    // ---- Metrics ----
+    // Nothing is timed unless a listener is attached
+    val currentMetrics by rememberUpdatedState(metrics)
+    val recorder = remember(metrics != null) { if (metrics != null) TurnRecorder() else null }
+    val view = LocalView.current
+    DisposableEffect(recorder, view) {
+        val window = view.context.findActivity()?.window
+        val jankStats = if (recorder != null && window != null) {
+            JankStats.createAndTrack(window) { frameData ->
+                if (frameData.isJank) recorder.recordJank()
+            }
+        } else {
+            null
+        }
+        onDispose { jankStats?.isTrackingEnabled = false }
+    }
+
+    // ---- Adaptive quality ----
+    val adaptive = remember(adaptiveQuality) { if (adaptiveQuality) AdaptiveQuality() else null }
+    DisposableEffect(adaptive, view) {
+        val powerManager = view.context.getSystemService(PowerManager::class.java)
+        val listener = if (adaptive != null && powerManager != null &&
+            Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q
+        ) {
+            adaptive.thermalStatus = powerManager.currentThermalStatus
+            PowerManager.OnThermalStatusChangedListener { adaptive.thermalStatus = it }.also {
+                powerManager.addThermalStatusListener(view.context.mainExecutor, it)
+            }
+        } else {
+            null
+        }
+        onDispose {
+            if (listener != null && Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+                powerManager?.removeThermalStatusListener(listener)
+            }
+        }
+    }
+
+    // ---- Memory pressure ----
+    // Trim levels shrink the provider's residency window; only a PageSource
+    // cache can give pages back, a caller's list stays as it is
+    DisposableEffect(view) {
+        val app = view.context.applicationContext
+        val callbacks = object : ComponentCallbacks2 {
+            override fun onTrimMemory(level: Int) {
+                pages.trimMemory(level)
+                currentMetrics?.onMemoryTrimmed(level, pages.residentBytes)
+            }
+
+            override fun onConfigurationChanged(newConfig: Configuration) {}
+
+            override fun onLowMemory() = onTrimMemory(ComponentCallbacks2.TRIM_MEMORY_RUNNING_CRITICAL)
+        }
+        app.registerComponentCallbacks(callbacks)
+        onDispose { app.unregisterComponentCallbacks(callbacks) }
+    }
+
+    fun beginTurn(fromDrag: Boolean) {
+        recorder?.begin(fromDrag)
+        adaptive?.beginTurn(view.display?.refreshRate ?: 0f)
+    }
+
+    fun finishTurn(forward: Boolean, turned: Boolean) {
+        recorder?.end(forward, turned, pages.residentBytes)?.let { currentMetrics?.onTurnMeasured(it) }
+        adaptive?.endTurn()
+    }
+
+    // Keep the visible page (or spread) and its neighbours available
+    LaunchedEffect(pages, pageCount, currentPage, twoUp) {
+        pages.prepare(currentPage.coerceAtMost(pageCount - 1), pageStep())
+    }
 
     // Report page changes
     LaunchedEffect(currentPage, pageCount) {
@@ -102,343 +463,665 @@ fun PageCurlContainer(
     }
 
     // ---- Animation helpers ----
-    fun animateToComplete(forward: Boolean) {
+    fun canTurn(forward: Boolean) = if (forward) currentPage + pageStep() < pageCount else currentPage > 0
+
+    fun animateToComplete(forward: Boolean, startX: Float, startY: Float, endX: Float, endY: Float) {
         val dir = if (forward) "forward" else "backward"
         Log.d(TAG, "animateComplete: $dir, page=${currentPage + 1}/$pageCount")
-        scope.launch {
-            isAnimCompleting = true
-            animProgress.snapTo(0f)
-            animProgress.animateTo(
-                1f,
-                tween(durationMillis = 300, easing = FastOutSlowInEasing)
+        turns.start(forward, completing = true, startX, startY, endX, endY)
+    }
+
+    fun animateToCancel(startX: Float, startY: Float, endX: Float, endY: Float) {
+        Log.d(TAG, "animateCancel: snapBack, page=${currentPage + 1}/$pageCount")
+        turns.start(curlForward, completing = false, startX, startY, endX, endY)
+    }
+
+    // Tap turns follow the precomputed table paths
+    fun startTapTurn(forward: Boolean) {
+        val leafW = if (twoUp) pageW / 2f else pageW
+        curlForward = forward
+        beginTurn(fromDrag = false)
+        if (forward) {
+            tapTurn = tapTables.forward
+            animateToComplete(
+                true, pageW, pageH,
+                pageW - leafW * (1f + TapTurnTables.OVERSHOOT), pageH * TapTurnTables.END_Y_FRACTION
             )
-            if (forward) {
-                if (currentPage < pageCount - 1) {
-                    currentPage++
+        } else {
+            tapTurn = tapTables.backward
+            animateToComplete(
+                false, 0f, pageH,
+                leafW * (1f + TapTurnTables.OVERSHOOT), pageH * TapTurnTables.END_Y_FRACTION
+            )
+        }
+    }
+
+    fun reachEdge(forward: Boolean) {
+        if (forward) {
+            Log.d(TAG, "reachEnd: page=${currentPage + 1}/$pageCount")
+            currentOnReachEnd()
+        } else {
+            Log.d(TAG, "reachStart: page=${currentPage + 1}/$pageCount")
+            currentOnReachStart()
+        }
+    }
+
+    // Fast flips need one bitmap page per leaf
+    fun canFastFlip() = !twoUp && pageContent == null
+
+    // Prefetch around where a flip lands rather than the pages it skips over
+    fun warmFlipTarget() {
+        pages.prepare(flip.targetPage.coerceIn(0, pageCount - 1), warm = true)
+    }
+
+    fun startFastFlip(forward: Boolean, count: Int) {
+        val available = if (forward) pageCount - 1 - currentPage else currentPage
+        val flipped = count.coerceAtMost(available)
+        Log.d(TAG, "fastFlip: ${if (forward) "forward" else "backward"}, pages=$flipped, page=${currentPage + 1}/$pageCount")
+        curlForward = forward
+        beginTurn(fromDrag = false)
+        flip.start(forward, currentPage, flipped)
+        warmFlipTarget()
+    }
+
+    /**
+     * A tap turn in [forward]: starts it, or while a turn is in flight
+     * queues it behind, cancels a queued opposite turn, or retargets the
+     * turn in flight (a snap-back becomes a completion and vice versa).
+     */
+    fun requestTapTurn(forward: Boolean) {
+        if (flip.isRunning) {
+            // Extend or trim the run in flight
+            if (forward != flip.forward) {
+                flip.shrink()
+            } else if (if (forward) flip.targetPage < pageCount - 1 else flip.targetPage > 0) {
+                flip.extend()
+                warmFlipTarget()
+            }
+            return
+        }
+        if (turns.isRunning) {
+            val sign = if (forward) 1 else -1
+            val leafW = if (twoUp) pageW / 2f else pageW
+            when {
+                turns.queued * sign < 0 -> turns.queued += sign
+                turns.forward == forward && turns.completing -> turns.queued += sign
+                turns.forward == forward -> {
+                    tapTurn = null
+                    val endX = if (forward) pageW - leafW * 1.3f else leafW * 1.3f
+                    turns.retarget(completing = true, endX, turns.cornerY * 0.5f + pageH * 0.25f)
+                }
+                turns.completing -> {
+                    tapTurn = null
+                    val originX = if (turns.forward) pageW else 0f
+                    val originY = if (turns.cornerY > pageH / 2) pageH else 0f
+                    turns.retarget(completing = false, originX, originY)
+                }
+                else -> turns.queued += sign
+            }
+            Log.d(TAG, "tapTurn: inFlight, queued=${turns.queued}")
+            return
+        }
+        if (curlActive) return
+        if (canTurn(forward)) startTapTurn(forward) else reachEdge(forward)
+    }
+
+    fun onTurnFinished(forward: Boolean, completed: Boolean) {
+        val startPage = currentPage
+        if (completed) {
+            if (canTurn(forward)) {
+                currentPage = if (forward) {
+                    currentPage + pageStep()
                 } else {
-                    Log.d(TAG, "reachEnd: page=${currentPage + 1}/$pageCount")
-                    onReachEnd()
+                    (currentPage - pageStep()).coerceAtLeast(0)
                 }
             } else {
-                if (currentPage > 0) {
-                    currentPage--
-                } else {
-                    Log.d(TAG, "reachStart: page=${currentPage + 1}/$pageCount")
-                    onReachStart()
+                reachEdge(forward)
+            }
+        }
+        curlActive = false
+        finishTurn(forward, turned = currentPage != startPage)
+    }
+
+    LaunchedEffect(turns) {
+        turns.run(
+            onFinished = ::onTurnFinished,
+            onNext = { forward ->
+                // Backlog left after taking this turn off the queue
+                val backlog = abs(turns.queued)
+                when {
+                    !canTurn(forward) -> {
+                        turns.queued = 0
+                        reachEdge(forward)
+                    }
+                    backlog > 0 && canFastFlip() -> {
+                        turns.queued = 0
+                        startFastFlip(forward, 1 + backlog)
+                    }
+                    else -> startTapTurn(forward)
                 }
             }
-            dragCorner = null
-            isAnimCompleting = false
+        )
+    }
+    LaunchedEffect(flip) {
+        flip.run { forward, page ->
+            // One page change for the whole run
+            currentPage = page.coerceIn(0, pageCount - 1)
+            curlActive = false
+            finishTurn(forward, turned = true)
         }
     }
 
-    fun animateToCancel() {
-        Log.d(TAG, "animateCancel: snapBack, page=${currentPage + 1}/$pageCount")
-        scope.launch {
-            isAnimCompleting = false
-            animProgress.snapTo(0f)
-            animProgress.animateTo(
-                1f,
-                spring(Spring.DampingRatioNoBouncy, Spring.StiffnessHigh)
-            )
-            dragCorner = null
+    // ---- Jumps from the hoisted state ----
+    fun jumpTarget(page: Int): Int {
+        val target = page.coerceIn(0, (pageCount - 1).coerceAtLeast(0))
+        return if (twoUp) target - target % 2 else target
+    }
+
+    // Drops a drag, turn or flip in flight, leaving the page where it is
+    fun stopTurn() {
+        val stopped = turns.grab() or flip.stop() or curlActive
+        if (!stopped) return
+        tapTurn = null
+        curlActive = false
+        finishTurn(curlForward, turned = false)
+    }
+
+    DisposableEffect(pageState) {
+        val controller = object : PageCurlState.Controller {
+            override fun snapTo(page: Int) {
+                stopTurn()
+                val target = jumpTarget(page)
+                Log.d(TAG, "snapToPage: ${target + 1}/$pageCount")
+                pages.prepare(target, pageStep())
+                currentPage = target
+            }
+
+            override suspend fun animateTo(page: Int) {
+                stopTurn()
+                val target = jumpTarget(page)
+                if (target == currentPage) return
+                Log.d(TAG, "animateToPage: ${currentPage + 1}→${target + 1}/$pageCount")
+                // Warm the landing page before the animation starts
+                pages.prepare(target, pageStep())
+                val forward = target > currentPage
+                val turnsAway = abs(target - currentPage) / pageStep()
+                when {
+                    pageW <= 0f -> currentPage = target
+                    turnsAway == 1 -> startTapTurn(forward)
+                    canFastFlip() -> startFastFlip(forward, turnsAway)
+                    else -> currentPage = target
+                }
+                snapshotFlow { turns.isRunning || flip.isRunning }.first { !it }
+            }
+        }
+        pageState.controller = controller
+        onDispose {
+            if (pageState.controller === controller) pageState.controller = null
         }
     }
 
-    // Reusable Paint objects (avoid allocation per frame)
+    // Reusable Paint for the flat page; curl layers are drawn by the renderer
     val bitmapPaint = remember { Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG) }
-    val backFacePaint = remember {
-        Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG).apply {
-            alpha = BACK_FACE_CONTENT_ALPHA
-        }
+    val density = LocalDensity.current.density
+    val context = LocalContext.current
+    val resolvedQuality = remember(quality) { quality.resolve(isLowRamDevice(context)) }
+    val drawer = remember(renderer, density, cachePageLayers, resolvedQuality) {
+        createCurlDrawer(renderer, density, cachePageLayers, resolvedQuality)
     }
-    val backOverlayPaint = remember {
-        Paint(Paint.ANTI_ALIAS_FLAG).apply {
-            color = android.graphics.Color.argb(BACK_FACE_OVERLAY_ALPHA, 255, 255, 255)
-            style = Paint.Style.FILL
-        }
+    DisposableEffect(drawer) {
+        onDispose { drawer.release() }
+    }
+    // Warm the drawer's caches for the page that will be curled next
+    // (the right leaf in a spread)
+    LaunchedEffect(drawer, pages, currentPage, twoUp) {
+        val next = if (twoUp) currentPage + 1 else currentPage
+        pages[next]?.let { drawer.prepare(it) }
+    }
+
+    // Reusable per-frame geometry (refilled in place by CurlMath.updateInto)
+    val frame = remember { CurlFrame() }
+    val dst = remember { RectF() }
+    val flatDst = remember { RectF() }
+    // Precomputed animated-turn geometry, when the native kernel is enabled
+    val trajectory = remember(nativeGeometry) {
+        if (nativeGeometry && CurlNative.isAvailable) CurlTrajectory() else null
+    }
+    // HARDWARE pages are copied only when drawn into a software canvas
+    val softwareFallback = remember { SoftwareBitmapFallback() }
+    // Recorded composable pages by index, registered by their slots
+    val contentLayers = remember { mutableStateMapOf<Int, GraphicsLayer>() }
+    val layerDrawer = remember(pageContent != null) { if (pageContent != null) LayerCurlDrawer() else null }
+    // Bitmap pages: the flat pages of a curl frame, cached so the curl
+    // layers are drawn only in the fold's dirty rectangle. Not for the cylinder,
+    // whose axis and crease shadow sit behind the fold, outside that box
+    val baseLayer = rememberGraphicsLayer()
+    val pageBase = remember(baseLayer, layerDrawer, drawer) {
+        if (layerDrawer == null && drawer !is CylinderCurlDrawer) PageBase(baseLayer) else null
+    }
+    // Bitmaps a recording still draws, so the page cache keeps them from the pool
+    val holdsBitmap = remember(pageBase, drawer) {
+        { bitmap: Bitmap -> pageBase?.holds(bitmap) == true || drawer.holds(bitmap) }
+    }
+    // Sees every MotionEvent; the draw pass reads one frame ahead of the drag
+    val predictor = remember(predictTouch, view, density) {
+        if (predictTouch) DragPredictor(view, DragPredictor.MAX_OFFSET_DP * density) else null
     }
-    val shadowPaint = remember { Paint(Paint.ANTI_ALIAS_FLAG) }
 
     // ---- Canvas rendering ----
-    androidx.compose.foundation.Canvas(
-        modifier = modifier
-            .fillMaxSize()
-            .onSizeChanged { size ->
-                pageW = size.width.toFloat()
-                pageH = size.height.toFloat()
-                Log.d(TAG, "sizeChanged: ${size.width}x${size.height}")
+    Box(modifier.fillMaxSize()) {
+        if (pageContent != null) {
+            // Hidden slots under the curl canvas, one per page in the window
+            val leafFraction = if (twoUp) 0.5f else 1f
+            val first = (currentPage - pageStep()).coerceAtLeast(0)
+            val last = (currentPage + 2 * pageStep() - 1).coerceAtMost(pageCount - 1)
+            for (index in first..last) {
+                key(index) {
+                    PageContentSlot(index, leafFraction, contentLayers, pageContent)
+                }
             }
-            // Drag gesture
-            .pointerInput(pageCount, currentPage) {
-                val velocityTracker = VelocityTracker()
-                detectDragGestures(
-                    onDragStart = { startOffset ->
-                        velocityTracker.resetTracking()
-                        curlForward = startOffset.x > size.width / 2
-
-                        // Corner starts at the page edge
-                        val cornerX = if (curlForward) size.width.toFloat() else 0f
-                        val cornerY = if (startOffset.y > size.height / 2) {
-                            size.height.toFloat()
-                        } else {
-                            0f
-                        }
-                        dragCorner = PointF(cornerX, cornerY)
-                        val dir = if (curlForward) "forward" else "backward"
-                        val corner = if (cornerY > 0) "bottom" else "top"
-                        Log.d(TAG, "dragStart: $dir, ${corner}Corner, offset=(${startOffset.x.toInt()},${startOffset.y.toInt()})")
-                    },
-                    onDrag = { change, dragAmount ->
-                        change.consume()
-                        velocityTracker.addPosition(change.uptimeMillis, change.position)
-
-                        dragCorner?.let { cp ->
-                            dragCorner = PointF(
-                                (cp.x + dragAmount.x).coerceIn(
+        }
+
+        androidx.compose.foundation.Canvas(
+            modifier = Modifier
+                .matchParentSize()
+                .onSizeChanged { size ->
+                    pageW = size.width.toFloat()
+                    pageH = size.height.toFloat()
+                    twoUp = spread.isTwoUp(pageW, pageH, density)
+                    // A spread always starts on its left page
+                    if (twoUp && currentPage % 2 == 1) currentPage--
+                    tapTables.rebuild(if (twoUp) pageW / 2f else pageW, pageH)
+                    Log.d(TAG, "sizeChanged: ${size.width}x${size.height}, twoUp=$twoUp")
+                }
+                .then(if (predictor != null) Modifier.motionEventSpy(predictor::record) else Modifier)
+                // Drag gesture; the page and the book are read through state,
+                // so neither page turns nor page-list changes restart it
+                .pointerInput(recorder, adaptive) {
+                    val velocityTracker = VelocityTracker()
+                    detectDragGestures(
+                        onDragStart = { startOffset ->
+                            velocityTracker.resetTracking()
+                            // A fast flip runs to the end; the drag is ignored
+                            if (flip.isRunning) return@detectDragGestures
+                            tapTurn = null
+                            if (turns.grab()) {
+                                // Take over the turn in flight where its corner is now
+                                dragX = turns.cornerX
+                                dragY = turns.cornerY
+                                curlForward = turns.forward
+                                curlActive = true
+                                Log.d(TAG, "dragStart: grabbed turn at (${dragX.toInt()},${dragY.toInt()})")
+                                return@detectDragGestures
+                            }
+                            beginTurn(fromDrag = true)
+                            curlForward = startOffset.x > size.width / 2
+
+                            // Corner starts at the page edge
+                            val cornerX = if (curlForward) size.width.toFloat() else 0f
+                            val cornerY = if (startOffset.y > size.height / 2) {
+                                size.height.toFloat()
+                            } else {
+                                0f
+                            }
+                            dragX = cornerX
+                            dragY = cornerY
+                            curlActive = true
+                            val dir = if (curlForward) "forward" else "backward"
+                            val corner = if (cornerY > 0) "bottom" else "top"
+                            Log.d(TAG, "dragStart: $dir, ${corner}Corner, offset=(${startOffset.x.toInt()},${startOffset.y.toInt()})")
+                        },
+                        onDrag = { change, dragAmount ->
+                            change.consume()
+                            // Includes the historical samples batched into this
+                            // change, so fast touch panels get a full-rate estimate
+                            velocityTracker.addPointerInputChange(change)
+
+                            if (curlActive) {
+                                dragX = (dragX + dragAmount.x).coerceIn(
                                     -size.width * 0.15f,
                                     size.width * 1.15f
-                                ),
-                                (cp.y + dragAmount.y).coerceIn(
+                                )
+                                dragY = (dragY + dragAmount.y).coerceIn(
                                     -size.height * 0.15f,
                                     size.height * 1.15f
                                 )
-                            )
-                        }
-                    },
-                    onDragEnd = {
-                        val vel = try {
-                            velocityTracker.calculateVelocity()
-                        } catch (_: Exception) {
-                            null
-                        }
-                        val vx = vel?.x ?: 0f
-                        val cp = dragCorner ?: return@detectDragGestures
-
-                        // Progress: how far the corner has moved from its origin
-                        val progress = if (curlForward) {
-                            (size.width - cp.x) / size.width
-                        } else {
-                            cp.x / size.width
-                        }
-
-                        val shouldComplete = if (abs(vx) > VELOCITY_THRESHOLD) {
-                            if (curlForward) vx < 0 else vx > 0
-                        } else {
-                            progress > COMPLETION_THRESHOLD
-                        }
-
-                        val canTurn = if (curlForward) {
-                            currentPage < pageCount - 1
-                        } else {
-                            currentPage > 0
-                        }
+                            }
+                        },
+                        onDragEnd = {
+                            val vel = try {
+                                velocityTracker.calculateVelocity()
+                            } catch (_: Exception) {
+                                null
+                            }
+                            val vx = vel?.x ?: 0f
+                            if (!curlActive) return@detectDragGestures
+                            val cx = dragX
+                            val cy = dragY
 
-                        val dir = if (curlForward) "forward" else "backward"
-                        val reason = if (abs(vx) > VELOCITY_THRESHOLD) "velocity" else "threshold"
-                        Log.d(TAG, "dragEnd: $dir, progress=${String.format("%.2f", progress)}, vx=${vx.toInt()}, $reason→${if (shouldComplete) "complete" else "cancel"}, canTurn=$canTurn, page=${currentPage + 1}/$pageCount")
+                            // Progress: how far the corner has moved from its origin,
+                            // relative to the width of the turning leaf
+                            val leafW = if (twoUp) size.width / 2f else size.width.toFloat()
+                            val progress = if (curlForward) {
+                                (size.width - cx) / leafW
+                            } else {
+                                cx / leafW
+                            }
 
-                        // Set up animation endpoints
-                        animStartPt = PointF(cp.x, cp.y)
-                        if (shouldComplete && canTurn) {
-                            animEndPt = if (curlForward) {
-                                PointF(-size.width * 0.3f, cp.y * 0.5f + size.height * 0.25f)
+                            val shouldComplete = if (abs(vx) > VELOCITY_THRESHOLD) {
+                                if (curlForward) vx < 0 else vx > 0
                             } else {
-                                PointF(size.width * 1.3f, cp.y * 0.5f + size.height * 0.25f)
+                                progress > COMPLETION_THRESHOLD
                             }
-                            animateToComplete(curlForward)
-                        } else {
-                            val originX = if (curlForward) size.width.toFloat() else 0f
-                            val originY = if (cp.y > size.height / 2) {
-                                size.height.toFloat()
+
+                            val canTurn = if (curlForward) {
+                                currentPage + pageStep() < pageCount
                             } else {
-                                0f
+                                currentPage > 0
                             }
-                            animEndPt = PointF(originX, originY)
-                            animateToCancel()
-                        }
-                    },
-                    onDragCancel = {
-                        Log.d(TAG, "dragCancel: page=${currentPage + 1}/$pageCount")
-                        val cp = dragCorner ?: return@detectDragGestures
-                        animStartPt = PointF(cp.x, cp.y)
-                        val originX = if (curlForward) pageW else 0f
-                        val originY = if (cp.y > pageH / 2) pageH else 0f
-                        animEndPt = PointF(originX, originY)
-                        animateToCancel()
-                    }
-                )
-            }
-            // Tap gesture
-            .pointerInput(pageCount, currentPage) {
-                detectTapGestures(
-                    onTap = { offset ->
-                        val third = size.width / 3
-                        val zone = when {
-                            offset.x < third -> "LEFT"
-                            offset.x > third * 2 -> "RIGHT"
-                            else -> "CENTER"
-                        }
-                        Log.d(TAG, "tap: zone=$zone, offset=(${offset.x.toInt()},${offset.y.toInt()}), page=${currentPage + 1}/$pageCount")
-                        when {
-                            offset.x < third -> {
-                                if (currentPage > 0) {
-                                    curlForward = false
-                                    animStartPt = PointF(0f, size.height.toFloat())
-                                    animEndPt = PointF(
-                                        size.width * 1.3f,
-                                        size.height * 0.25f
-                                    )
-                                    animateToComplete(false)
+
+                            val dir = if (curlForward) "forward" else "backward"
+                            val reason = if (abs(vx) > VELOCITY_THRESHOLD) "velocity" else "threshold"
+                            Log.d(TAG, "dragEnd: $dir, progress=${String.format("%.2f", progress)}, vx=${vx.toInt()}, $reason→${if (shouldComplete) "complete" else "cancel"}, canTurn=$canTurn, page=${currentPage + 1}/$pageCount")
+
+                            // Set up animation endpoints
+                            if (shouldComplete && canTurn) {
+                                val endX = if (curlForward) {
+                                    size.width - leafW * 1.3f
                                 } else {
-                                    onReachStart()
+                                    leafW * 1.3f
                                 }
-                            }
-
-                            offset.x > third * 2 -> {
-                                if (currentPage < pageCount - 1) {
-                                    curlForward = true
-                                    animStartPt = PointF(
-                                        size.width.toFloat(),
-                                        size.height.toFloat()
-                                    )
-                                    animEndPt = PointF(
-                                        -size.width * 0.3f,
-                                        size.height * 0.25f
-                                    )
-                                    animateToComplete(true)
+                                animateToComplete(curlForward, cx, cy, endX, cy * 0.5f + size.height * 0.25f)
+                            } else {
+                                val originX = if (curlForward) size.width.toFloat() else 0f
+                                val originY = if (cy > size.height / 2) {
+                                    size.height.toFloat()
                                 } else {
-                                    onReachEnd()
+                                    0f
                                 }
+                                animateToCancel(cx, cy, originX, originY)
                             }
-
-                            else -> onTap()
+                        },
+                        onDragCancel = {
+                            Log.d(TAG, "dragCancel: page=${currentPage + 1}/$pageCount")
+                            if (!curlActive) return@detectDragGestures
+                            val originX = if (curlForward) pageW else 0f
+                            val originY = if (dragY > pageH / 2) pageH else 0f
+                            animateToCancel(dragX, dragY, originX, originY)
                         }
-                    }
-                )
-            }
-    ) {
-        drawIntoCanvas { canvas ->
-            val nc = canvas.nativeCanvas
-            val w = size.width
-            val h = size.height
-            val dst = RectF(0f, 0f, w, h)
-
-            nc.drawColor(bgArgb)
-
-            if (pages.isEmpty() || w <= 0f || h <= 0f) return@drawIntoCanvas
-
-            // Compute effective corner position from drag or animation
-            val effectiveCorner: PointF? = when {
-                dragCorner != null && !animProgress.isRunning -> dragCorner
-                animProgress.isRunning -> {
-                    val t = animProgress.value
-                    PointF(
-                        animStartPt.x + (animEndPt.x - animStartPt.x) * t,
-                        animStartPt.y + (animEndPt.y - animStartPt.y) * t
                     )
                 }
+                // Tap gesture
+                .pointerInput(recorder, adaptive) {
+                    detectTapGestures(
+                        // Holding a side third keeps requesting turns, which
+                        // queue up and collapse into a fast flip
+                        onPress = { offset ->
+                            val third = size.width / 3
+                            val forward = when {
+                                offset.x < third -> false
+                                offset.x > third * 2 -> true
+                                else -> null
+                            }
+                            if (forward != null) {
+                                coroutineScope {
+                                    val repeat = launch {
+                                        delay(viewConfiguration.longPressTimeoutMillis)
+                                        while (true) {
+                                            requestTapTurn(forward)
+                                            delay(HOLD_REPEAT_MILLIS)
+                                        }
+                                    }
+                                    tryAwaitRelease()
+                                    repeat.cancel()
+                                }
+                            }
+                        },
+                        // Side holds are handled above; a centre hold still counts as a tap
+                        onLongPress = { offset ->
+                            val third = size.width / 3
+                            if (offset.x >= third && offset.x <= third * 2) currentOnTap()
+                        },
+                        onTap = { offset ->
+                            val third = size.width / 3
+                            val zone = when {
+                                offset.x < third -> "LEFT"
+                                offset.x > third * 2 -> "RIGHT"
+                                else -> "CENTER"
+                            }
+                            Log.d(TAG, "tap: zone=$zone, offset=(${offset.x.toInt()},${offset.y.toInt()}), page=${currentPage + 1}/$pageCount")
+                            when {
+                                offset.x < third -> requestTapTurn(forward = false)
+                                offset.x > third * 2 -> requestTapTurn(forward = true)
+                                else -> currentOnTap()
+                            }
+                        }
+                    )
+                }
+        ) {
+            drawIntoCanvas { canvas ->
+                pages.recycleRetired(holdsBitmap)
+                val timing = recorder != null && recorder.isActive
+                val drawStart = if (timing) System.nanoTime() else 0L
+                val nc = canvas.nativeCanvas
+                val w = size.width
+                val h = size.height
+                // The turning leaf: the whole page, or one half of a spread
+                val leafW = if (twoUp) w / 2f else w
+                if (dst.right != leafW || dst.bottom != h) dst.set(0f, 0f, leafW, h)
 
-                else -> null
-            }
-
-            if (effectiveCorner == null) {
-                // No curl: draw current page flat
-                pages.getOrNull(currentPage)?.let { bmp ->
-                    nc.drawBitmap(bmp, null, dst, bitmapPaint)
+                // The background is cleared by each path below: a curl over
+                // the cached base only clears its dirty rectangle
+                if (pageCount == 0 || w <= 0f || h <= 0f) {
+                    nc.drawColor(bgArgb)
+                    return@drawIntoCanvas
                 }
-                return@drawIntoCanvas
-            }
 
-            // Determine the original corner position
-            val originCorner = if (curlForward) {
-                val cy = if (effectiveCorner.y < h / 2) 0f else h
-                PointF(w, cy)
-            } else {
-                val cy = if (effectiveCorner.y < h / 2) 0f else h
-                PointF(0f, cy)
-            }
+                if (flip.isRunning) {
+                    nc.drawColor(bgArgb)
+                    flip.draw(nc, dst, pages, softwareFallback, bgArgb)
+                    return@drawIntoCanvas
+                }
 
-            // Calculate fold geometry
-            val frame = CurlMath.calculate(effectiveCorner, originCorner, w, h)
+                // Static pages are plain bitmap draws, with no clip work
+                fun drawFlat(index: Int, left: Float, width: Float) {
+                    if (layerDrawer != null) {
+                        contentLayers[index]?.let { layer -> translate(left, 0f) { drawLayer(layer) } }
+                        return
+                    }
+                    softwareFallback.drawable(pages[index], nc)?.let { bmp ->
+                        flatDst.set(left, 0f, left + width, h)
+                        nc.drawBitmap(bmp, null, flatDst, bitmapPaint)
+                    }
+                }
 
-            if (!frame.isVisible) {
-                // Fold line outside page — just draw flat
-                pages.getOrNull(currentPage)?.let { bmp ->
-                    nc.drawBitmap(bmp, null, dst, bitmapPaint)
+                fun drawFlatPages() {
+                    nc.drawColor(bgArgb)
+                    drawFlat(currentPage, 0f, leafW)
+                    if (twoUp) drawFlat(currentPage + 1, leafW, leafW)
                 }
-                return@drawIntoCanvas
-            }
 
-            // ---- 5-layer rendering ----
+                // Compute effective corner position from drag or animation
+                val ex: Float
+                val ey: Float
+                when {
+                    curlActive && !turns.isRunning -> {
+                        if (predictor != null) {
+                            predictor.predict()
+                            ex = (dragX + predictor.dx).coerceIn(-w * 0.15f, w * 1.15f)
+                            ey = (dragY + predictor.dy).coerceIn(-h * 0.15f, h * 1.15f)
+                        } else {
+                            ex = dragX
+                            ey = dragY
+                        }
+                        adaptive?.onDragFrame(System.nanoTime())
+                    }
 
-            // Layer 1: Revealed page (next or prev) — drawn full underneath
-            val revealedBmp = if (curlForward) {
-                pages.getOrNull(currentPage + 1)
-            } else {
-                pages.getOrNull(currentPage - 1)
-            }
-            if (revealedBmp != null) {
-                nc.save()
-                nc.clipPath(frame.backPath)
-                nc.drawBitmap(revealedBmp, null, dst, bitmapPaint)
-                nc.restore()
-            }
+                    turns.isRunning -> {
+                        ex = turns.cornerX
+                        ey = turns.cornerY
+                    }
 
-            // Layer 2: Cast shadow on revealed page (along fold line, curl side)
-            if (frame.castShadowGradient != null && !frame.shadowRegionPath.isEmpty) {
-                shadowPaint.shader = frame.castShadowGradient
-                nc.save()
-                nc.clipPath(frame.shadowRegionPath)
-                nc.drawRect(0f, 0f, w, h, shadowPaint)
-                nc.restore()
-                shadowPaint.shader = null
-            }
+                    else -> {
+                        // No curl: draw current page (or spread) flat
+                        drawFlatPages()
+                        return@drawIntoCanvas
+                    }
+                }
 
-            // Layer 3: Flat part of current page (front face, uncurled)
-            pages.getOrNull(currentPage)?.let { bmp ->
-                nc.save()
-                nc.clipPath(frame.flatPath)
-                nc.drawBitmap(bmp, null, dst, bitmapPaint)
-                nc.restore()
-            }
+                // Geometry is computed in the leaf's own coordinates; a forward
+                // turn in a spread moves the right leaf, offset by half the width
+                val leafX = if (twoUp && curlForward) leafW else 0f
 
-            // Layer 4: Crease shadow on flat page (along fold line, flat side)
-            if (frame.creaseShadowGradient != null && !frame.creaseRegionPath.isEmpty) {
-                shadowPaint.shader = frame.creaseShadowGradient
-                nc.save()
-                nc.clipPath(frame.creaseRegionPath)
-                nc.drawRect(0f, 0f, w, h, shadowPaint)
-                nc.restore()
-                shadowPaint.shader = null
-            }
+                // Determine the original corner position
+                val originX = if (curlForward) leafW else 0f
+                val originY = if (ey < h / 2) 0f else h
 
-            // Layer 5: Back face of curled page (full curl region — flat paper being turned)
-            if (!frame.backPath.isEmpty) {
-                pages.getOrNull(currentPage)?.let { bmp ->
-                    nc.save()
-                    nc.clipPath(frame.backPath)
-                    nc.concat(frame.backMatrix)
-                    nc.drawBitmap(bmp, null, dst, backFacePaint)
-                    nc.restore()
+                // Refresh fold geometry only if the corner or page size moved.
+                // Animated turns follow a straight path known up front: tap turns
+                // read the tables built on size change, and with the native
+                // kernel other animations build their path on the first frame.
+                val calcStart = if (timing) System.nanoTime() else 0L
+                val tapTable = tapTurn
+                if (tapTable != null && turns.isRunning && tapTable.isBuiltFor(leafW, h)) {
+                    tapTable.loadInto(frame, turns.progress)
+                } else if (trajectory != null && turns.isRunning &&
+                    trajectory.prepare(
+                        turns.startX - leafX, turns.startY, turns.endX - leafX, turns.endY,
+                        originX, leafW, h
+                    )
+                ) {
+                    trajectory.loadInto(frame, turns.progress)
+                } else {
+                    CurlMath.updateInto(frame, ex - leafX, ey, originX, originY, leafW, h)
+                }
+                val calcNanos = if (timing) System.nanoTime() - calcStart else 0L
+
+                if (!frame.isVisible) {
+                    // Fold line outside page — just draw flat
+                    drawFlatPages()
+                    if (timing) recorder?.recordFrame(calcNanos, System.nanoTime() - drawStart, curlVisible = false)
+                    return@drawIntoCanvas
+                }
 
-                    // Paper-back white overlay for realistic look
+                val leafIndex = if (twoUp && curlForward) currentPage + 1 else currentPage
+                val step = if (twoUp) 2 else 1
+                val stepDown = adaptive?.stepDown ?: StepDown.NONE
+                val dirty = frame.dirtyBounds
+                if (pageBase != null && !dirty.isEmpty) {
+                    // Flat pages from the cached base; the fold's bounding box
+                    // is cleared and drawn as a full curl frame on top
+                    val left = softwareFallback.drawable(pages[currentPage], nc)
+                    val right = if (twoUp) softwareFallback.drawable(pages[currentPage + 1], nc) else null
+                    pageBase.draw(this, left, right, leafW, bgArgb)
+                    val revealedBmp = softwareFallback.drawable(pages[if (curlForward) leafIndex + step else leafIndex - step], nc)
+                    val currentBmp = if (leafIndex == currentPage) left else right
                     nc.save()
-                    nc.clipPath(frame.backPath)
-                    nc.drawRect(0f, 0f, w, h, backOverlayPaint)
+                    nc.translate(leafX, 0f)
+                    nc.clipRect(dirty)
+                    nc.drawColor(bgArgb)
+                    drawer.draw(nc, frame, currentBmp, revealedBmp, dst, stepDown)
                     nc.restore()
+                    if (timing) recorder?.recordFrame(calcNanos, System.nanoTime() - drawStart, curlVisible = true)
+                    return@drawIntoCanvas
                 }
 
-                // Layer 6: Curl cylinder highlight gradient (3D illusion)
-                if (frame.curlHighlightGradient != null) {
-                    shadowPaint.shader = frame.curlHighlightGradient
+                // In a spread the facing page stays put on the other half
+                nc.drawColor(bgArgb)
+                if (twoUp) {
+                    if (curlForward) drawFlat(currentPage, 0f, leafW) else drawFlat(currentPage + 1, leafW, leafW)
+                }
+                if (layerDrawer != null) {
+                    val revealedIndex = if (curlForward) leafIndex + step else leafIndex - step
+                    translate(leafX, 0f) {
+                        layerDrawer.draw(
+                            this, nc, frame,
+                            contentLayers[leafIndex], contentLayers[revealedIndex],
+                            leafW, h, stepDown
+                        )
+                    }
+                    if (timing) recorder?.recordFrame(calcNanos, System.nanoTime() - drawStart, curlVisible = true)
+                    return@drawIntoCanvas
+                }
+                val revealedBmp = if (curlForward) {
+                    softwareFallback.drawable(pages[leafIndex + step], nc)
+                } else {
+                    softwareFallback.drawable(pages[leafIndex - step], nc)
+                }
+                val currentBmp = softwareFallback.drawable(pages[leafIndex], nc)
+                if (leafX != 0f) {
                     nc.save()
-                    nc.clipPath(frame.curlStripPath)
-                    nc.drawRect(0f, 0f, w, h, shadowPaint)
+                    nc.translate(leafX, 0f)
+                    drawer.draw(nc, frame, currentBmp, revealedBmp, dst, stepDown)
                     nc.restore()
-                    shadowPaint.shader = null
+                } else {
+                    drawer.draw(nc, frame, currentBmp, revealedBmp, dst, stepDown)
                 }
+                if (timing) recorder?.recordFrame(calcNanos, System.nanoTime() - drawStart, curlVisible = true)
             }
         }
     }
 }
+
+private tailrec fun Context.findActivity(): Activity? = when (this) {
+    is Activity -> this
+    is ContextWrapper -> baseContext.findActivity()
+    else -> null
+}
+
+/**
+ * The container's first frame: the page (or spread) it opens at, scaled
+ * into place with one paint and no curl or gesture state.
+ */
+@Composable
+private fun FirstPage(pages: PageProvider, page: Int, spread: PageSpread, background: Int, modifier: Modifier) {
+    val paint = remember { Paint(Paint.ANTI_ALIAS_FLAG or Paint.FILTER_BITMAP_FLAG) }
+    val dst = remember { RectF() }
+    val density = LocalDensity.current.density
+    androidx.compose.foundation.Canvas(modifier.fillMaxSize()) {
+        drawIntoCanvas { canvas ->
+            val nc = canvas.nativeCanvas
+            nc.drawColor(background)
+            fun drawPage(index: Int, left: Float, right: Float) {
+                val bmp = pages[index] ?: return
+                // HARDWARE pages need the main pass's software copy; leave them to it
+                if (!nc.isHardwareAccelerated && bmp.config == Bitmap.Config.HARDWARE) return
+                dst.set(left, 0f, right, size.height)
+                nc.drawBitmap(bmp, null, dst, paint)
+            }
+            if (spread.isTwoUp(size.width, size.height, density)) {
+                val left = page - page % 2
+                drawPage(left, 0f, size.width / 2f)
+                drawPage(left + 1, size.width / 2f, size.width)
+            } else {
+                drawPage(page, 0f, size.width)
+            }
+        }
+    }
+}
+
+/**
+ * One hidden page slot: lays out [content] at the leaf size and records its
+ * drawing into a layer registered under [index], without drawing it here.
+ */
+@Composable
+private fun PageContentSlot(
+    index: Int,
+    leafFraction: Float,
+    layers: MutableMap<Int, GraphicsLayer>,
+    content: @Composable (index: Int) -> Unit
+) {
+    val layer = rememberGraphicsLayer()
+    DisposableEffect(layer) {
+        layers[index] = layer
+        onDispose { layers.remove(index) }
+    }
+    Box(
+        Modifier
+            .fillMaxHeight()
+            .fillMaxWidth(leafFraction)
+            .drawWithContent { layer.record { this@drawWithContent.drawContent() } }
+    ) {
+        content(index)
+    }
+}
@@ -0,0 +1,142 @@
+package io.github.readmigo.pagecurl
+
+import java.util.Arrays
+
+/**
+ * Receives one [PageTurnMetrics] per page turn (or cancelled drag).
+ *
+ * Pass an instance as `metrics` to [PageCurlContainer]; with no listener the
+ * container takes no timestamps at all. Called on the main thread.
+ */
+fun interface PageCurlMetrics {
+    fun onTurnMeasured(metrics: PageTurnMetrics)
+
+    /**
+     * Called after the container shrank its page residency for an
+     * `onTrimMemory` [level] (a `ComponentCallbacks2.TRIM_MEMORY_*` value),
+     * with the page bitmap bytes still held afterwards.
+     */
+    fun onMemoryTrimmed(level: Int, residentBytes: Long) {}
+}
+
+/**
+ * Cost of a single page turn, from the start of the drag or tap until the
+ * curl animation settles.
+ *
+ * Times are nanoseconds of wall time on the UI thread. Percentiles cover
+ * the first 256 frames; longer turns keep counting [frameCount] and
+ * [jankyFrameCount] but stop sampling times.
+ *
+ * @property frameCount          Curl frames drawn during the turn.
+ * @property calculateNanosP50   Median time spent computing fold geometry.
+ * @property calculateNanosP95   95th percentile of the geometry time.
+ * @property calculateNanosMax   Slowest geometry computation.
+ * @property drawNanosP50        Median time spent in the whole draw pass.
+ * @property drawNanosP95        95th percentile of the draw pass time.
+ * @property drawNanosMax        Slowest draw pass.
+ * @property jankyFrameCount     Frames JankStats flagged as janky during the turn.
+ * @property firstCurlLatencyNanos Time from drag start to the first frame that
+ *                               showed a visible curl; -1 for tap turns or
+ *                               drags that never curled.
+ * @property forward             Direction of the turn.
+ * @property turned              Whether the page actually changed.
+ * @property residentBytes       Bytes of page bitmaps held for drawing when the
+ *                               turn ended: cached pages and placeholders for a
+ *                               [PageSource], the whole list for `List<Bitmap>`.
+ */
+data class PageTurnMetrics(
+    val frameCount: Int,
+    val calculateNanosP50: Long,
+    val calculateNanosP95: Long,
+    val calculateNanosMax: Long,
+    val drawNanosP50: Long,
+    val drawNanosP95: Long,
+    val drawNanosMax: Long,
+    val jankyFrameCount: Int,
+    val firstCurlLatencyNanos: Long,
+    val forward: Boolean,
+    val turned: Boolean,
+    val residentBytes: Long = 0L
+)
+
+/**
+ * Collects per-frame timings for one turn at a time into preallocated
+ * buffers, so recording a frame allocates nothing.
+ */
+internal class TurnRecorder(private val capacity: Int = MAX_SAMPLES) {
+
+    private val calculateNanos = LongArray(capacity)
+    private val drawNanos = LongArray(capacity)
+    private var samples = 0
+    private var frames = 0
+    private var jankyFrames = 0
+    private var dragStartNanos = -1L
+    private var firstCurlNanos = -1L
+
+    /** Whether a turn is being recorded. */
+    var isActive = false
+        private set
+
+    /** Starts a new turn, discarding any unfinished one. */
+    fun begin(fromDrag: Boolean) {
+        samples = 0
+        frames = 0
+        jankyFrames = 0
+        dragStartNanos = if (fromDrag) System.nanoTime() else -1L
+        firstCurlNanos = -1L
+        isActive = true
+    }
+
+    /** Records one drawn frame; [curlVisible] marks the first curl frame. */
+    fun recordFrame(calculateNanos: Long, drawNanos: Long, curlVisible: Boolean) {
+        if (!isActive) return
+        frames++
+        if (curlVisible && firstCurlNanos < 0L && dragStartNanos >= 0L) {
+            firstCurlNanos = System.nanoTime()
+        }
+        if (samples < capacity) {
+            this.calculateNanos[samples] = calculateNanos
+            this.drawNanos[samples] = drawNanos
+            samples++
+        }
+    }
+
+    /** Counts a frame reported janky by JankStats while the turn is active. */
+    fun recordJank() {
+        if (isActive) jankyFrames++
+    }
+
+    /** Ends the current turn and summarises it, or returns null if none was active. */
+    fun end(forward: Boolean, turned: Boolean, residentBytes: Long): PageTurnMetrics? {
+        if (!isActive) return null
+        isActive = false
+        Arrays.sort(calculateNanos, 0, samples)
+        Arrays.sort(drawNanos, 0, samples)
+        return PageTurnMetrics(
+            frameCount = frames,
+            calculateNanosP50 = percentile(calculateNanos, 50),
+            calculateNanosP95 = percentile(calculateNanos, 95),
+            calculateNanosMax = percentile(calculateNanos, 100),
+            drawNanosP50 = percentile(drawNanos, 50),
+            drawNanosP95 = percentile(drawNanos, 95),
+            drawNanosMax = percentile(drawNanos, 100),
+            jankyFrameCount = jankyFrames,
+            firstCurlLatencyNanos = if (firstCurlNanos >= 0L) firstCurlNanos - dragStartNanos else -1L,
+            forward = forward,
+            turned = turned,
+            residentBytes = residentBytes
+        )
+    }
+
+    /** Nearest-rank percentile of the first [samples] sorted values. */
+    private fun percentile(sorted: LongArray, p: Int): Long {
+        if (samples == 0) return 0L
+        val rank = (p * samples + 99) / 100
+        return sorted[(rank - 1).coerceIn(0, samples - 1)]
+    }
+
+    companion object {
+        /** About four seconds of frames at 60 Hz. */
+        const val MAX_SAMPLES = 256
+    }
+}
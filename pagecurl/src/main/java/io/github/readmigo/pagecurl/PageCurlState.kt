@@ -0,0 +1,74 @@
+package io.github.readmigo.pagecurl
+
+import androidx.compose.runtime.Composable
+import androidx.compose.runtime.Stable
+import androidx.compose.runtime.getValue
+import androidx.compose.runtime.mutableIntStateOf
+import androidx.compose.runtime.saveable.Saver
+import androidx.compose.runtime.saveable.rememberSaveable
+import androidx.compose.runtime.setValue
+
+/**
+ * Hoisted state of a [PageCurlContainer]: the current page, and jumps to
+ * another page from outside the container (a table of contents, a search
+ * result).
+ *
+ * The state is not tied to the page list, so a container whose pages grow
+ * (chapters appended as they are paginated) keeps its place; if the list
+ * shrinks past the current page, the page is clamped to the last one.
+ * Create it with [rememberPageCurlState] and pass it to the container.
+ *
+ * @param initialPage 0-based page the container opens at.
+ */
+@Stable
+class PageCurlState(initialPage: Int = 0) {
+
+    /** 0-based current page; the left page in a two-page spread. */
+    var currentPage by mutableIntStateOf(initialPage.coerceAtLeast(0))
+        internal set
+
+    /** Pages in the attached container; 0 while none is attached. */
+    var pageCount by mutableIntStateOf(0)
+        internal set
+
+    /** The attached container's side of the jumps; null while detached. */
+    internal var controller: Controller? = null
+
+    /**
+     * Turns to [page] (0-based, clamped to the book) with an animation: a
+     * single curl to a neighbouring page, otherwise a fast flip over the
+     * pages in between. The prefetcher is pointed at [page] before the
+     * animation starts. A turn already in flight is dropped.
+     *
+     * Suspends until the container settles on [page]. Where a fast flip is
+     * not available (two-page spreads, composable pages) longer jumps snap.
+     */
+    suspend fun animateToPage(page: Int) {
+        val c = controller
+        if (c != null) c.animateTo(page) else currentPage = page.coerceAtLeast(0)
+    }
+
+    /** Jumps to [page] (0-based, clamped to the book) without animating. */
+    fun snapToPage(page: Int) {
+        val c = controller
+        if (c != null) c.snapTo(page) else currentPage = page.coerceAtLeast(0)
+    }
+
+    internal interface Controller {
+        fun snapTo(page: Int)
+        suspend fun animateTo(page: Int)
+    }
+
+    companion object {
+        /** Saves the current page across configuration changes and process death. */
+        val Saver: Saver<PageCurlState, Int> = Saver(
+            save = { it.currentPage },
+            restore = { PageCurlState(it) }
+        )
+    }
+}
+
+/** Creates a [PageCurlState] that is remembered and saved across recreation. */
+@Composable
+fun rememberPageCurlState(initialPage: Int = 0): PageCurlState =
+    rememberSaveable(saver = PageCurlState.Saver) { PageCurlState(initialPage) }
@@ -0,0 +1,88 @@
+package io.github.readmigo.pagecurl
+
+import android.app.ActivityManager
+import android.content.Context
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.util.Log
+
+private const val TAG = "PageCurl"
+
+/**
+ * Pixel format that lazily loaded pages are converted to before they are
+ * cached and drawn.
+ *
+ * Every render layer, including the reflected back face, accepts
+ * [Bitmap.Config.ARGB_8888], [Bitmap.Config.RGB_565] and
+ * [Bitmap.Config.HARDWARE] pages, so this only trades memory and upload
+ * cost against fidelity.
+ */
+enum class PageFormat {
+    /** Keep whatever [PageSource.loadPage] returns. */
+    ORIGINAL,
+
+    /**
+     * Pick the cheapest format per device and page: opaque pages become
+     * [RGB_565] on low-RAM devices (half the memory) and [HARDWARE]
+     * elsewhere (no per-draw texture upload); translucent pages become
+     * [HARDWARE].
+     */
+    AUTO,
+
+    /** Software 32-bit pages. */
+    ARGB_8888,
+
+    /** Software 16-bit pages; alpha is dropped. Suits opaque text pages. Converted copies are not poolable. */
+    RGB_565,
+
+    /** GPU-resident, immutable pages. Not poolable. */
+    HARDWARE;
+
+    /**
+     * Converts [bitmap] to this format, returning [bitmap] itself when it
+     * already matches or conversion fails. Copies are immutable, so the
+     * page cache does not pool them. Call off the main thread.
+     */
+    internal fun convert(bitmap: Bitmap, lowRamDevice: Boolean): Bitmap {
+        val target = when (this) {
+            ORIGINAL -> return bitmap
+            AUTO -> if (!bitmap.hasAlpha() && lowRamDevice) Bitmap.Config.RGB_565 else Bitmap.Config.HARDWARE
+            ARGB_8888 -> Bitmap.Config.ARGB_8888
+            RGB_565 -> Bitmap.Config.RGB_565
+            HARDWARE -> Bitmap.Config.HARDWARE
+        }
+        if (bitmap.config == target) return bitmap
+        return try {
+            bitmap.copy(target, false) ?: bitmap
+        } catch (e: RuntimeException) {
+            Log.w(TAG, "page conversion to $target failed: ${e.message}")
+            bitmap
+        }
+    }
+}
+
+internal fun isLowRamDevice(context: Context): Boolean =
+    (context.getSystemService(Context.ACTIVITY_SERVICE) as? ActivityManager)?.isLowRamDevice == true
+
+/**
+ * Software copies of hardware pages for the rare canvas that is not
+ * hardware accelerated (e.g. `View.draw` into a bitmap for a screenshot),
+ * which cannot read [Bitmap.Config.HARDWARE]. Holds at most [capacity]
+ * copies, enough for the current page and both neighbours.
+ */
+internal class SoftwareBitmapFallback(private val capacity: Int = 3) {
+
+    private val copies = LinkedHashMap<Bitmap, Bitmap>(capacity + 1, 0.75f, true)
+
+    /** [bitmap] if [canvas] can draw it as-is, otherwise a cached software copy. */
+    fun drawable(bitmap: Bitmap?, canvas: Canvas): Bitmap? {
+        if (bitmap == null || canvas.isHardwareAccelerated || bitmap.config != Bitmap.Config.HARDWARE) {
+            return bitmap
+        }
+        copies[bitmap]?.let { return it }
+        val copy = bitmap.copy(Bitmap.Config.ARGB_8888, false) ?: return null
+        copies[bitmap] = copy
+        if (copies.size > capacity) copies.remove(copies.keys.first())
+        return copy
+    }
+}
@@ -0,0 +1,70 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Paint
+import android.graphics.RectF
+import android.graphics.RenderNode
+import android.os.Build
+import androidx.annotation.RequiresApi
+import kotlin.math.ceil
+
+/**
+ * A page bitmap recorded once, scaled into its destination, into a
+ * [RenderNode] backed by a compositing layer.
+ *
+ * HWUI renders the node into an offscreen texture only when it is
+ * re-recorded, so drawing it under a new clip or transform every frame
+ * composites the cached texture instead of re-filtering the source bitmap.
+ * The node is re-recorded when the bitmap, its pixels or the destination
+ * change.
+ *
+ * @param contentAlpha Opacity the page is recorded with (0-255).
+ * @param overlayColor Color filled over the page inside the layer (0 for none),
+ *                     used to bake the back-face tint into the composite.
+ */
+@RequiresApi(Build.VERSION_CODES.Q)
+internal class PageLayer(
+    contentAlpha: Int = 255,
+    private val overlayColor: Int = 0
+) {
+
+    private val node = RenderNode("PageCurlLayer").apply {
+        setUseCompositingLayer(true, null)
+    }
+    private val paint = Paint(Paint.FILTER_BITMAP_FLAG).apply { alpha = contentAlpha }
+    private val bounds = RectF()
+    private var bitmap: Bitmap? = null
+    private var generationId = 0
+
+    /** Draws [bmp] scaled into [dst] via the cached layer. */
+    fun draw(canvas: Canvas, bmp: Bitmap, dst: RectF) {
+        if (bmp !== bitmap || bmp.generationId != generationId || dst != bounds || !node.hasDisplayList()) {
+            record(bmp, dst)
+        }
+        canvas.drawRenderNode(node)
+    }
+
+    /** Whether the recording draws [bmp]. */
+    fun holds(bmp: Bitmap): Boolean = bmp === bitmap
+
+    /** Drops the recording and its offscreen texture. */
+    fun release() {
+        node.discardDisplayList()
+        bitmap = null
+    }
+
+    private fun record(bmp: Bitmap, dst: RectF) {
+        node.setPosition(0, 0, ceil(dst.right).toInt(), ceil(dst.bottom).toInt())
+        val c = node.beginRecording()
+        try {
+            c.drawBitmap(bmp, null, dst, paint)
+            if (overlayColor != 0) c.drawColor(overlayColor)
+        } finally {
+            node.endRecording()
+        }
+        bitmap = bmp
+        generationId = bmp.generationId
+        bounds.set(dst)
+    }
+}
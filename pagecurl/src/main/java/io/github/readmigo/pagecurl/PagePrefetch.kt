@@ -0,0 +1,32 @@
+package io.github.readmigo.pagecurl
+
+/**
+ * Prefetch window and cache budget for a lazily loaded [PageSource].
+ *
+ * The window is biased toward the direction of the last turn: after a
+ * forward turn [ahead] pages after the current one and [behind] before it
+ * are kept decoded, and the other way round after a backward turn.
+ *
+ * @property ahead           Pages to prefetch in the reading direction.
+ * @property behind          Pages to keep against the reading direction.
+ * @property maxCacheBytes   Byte budget for decoded pages (LRU-evicted).
+ * @property placeholderScale Downscale divisor for the low-res copies kept
+ *                           as placeholders; 0 disables them.
+ */
+data class PagePrefetch(
+    val ahead: Int = 2,
+    val behind: Int = 1,
+    val maxCacheBytes: Int = DEFAULT_CACHE_BYTES,
+    val placeholderScale: Int = 8
+) {
+    init {
+        require(ahead >= 1 && behind >= 1) { "the window must include both neighbours" }
+        require(maxCacheBytes > 0) { "maxCacheBytes must be positive" }
+        require(placeholderScale >= 0) { "placeholderScale must not be negative" }
+    }
+
+    companion object {
+        /** Room for about six 1080x2400 ARGB_8888 pages. */
+        const val DEFAULT_CACHE_BYTES = 64 * 1024 * 1024
+    }
+}
@@ -0,0 +1,117 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.emptyFlow
+
+/**
+ * Supplies page bitmaps on demand to [PageCurlContainer].
+ *
+ * The container keeps a small window of pages around the current one
+ * (see [PagePrefetch]), so memory stays constant regardless of book length.
+ *
+ * A source may grow or change while it is shown (chapters paginated in the
+ * background): update [pageCount] and emit the affected pages from
+ * [invalidations]. Only those pages are dropped or reloaded, and the
+ * container only redraws if one of them is on screen or next to it; the
+ * current page and any curl in progress are left alone.
+ */
+interface PageSource {
+
+    /** Total number of pages. */
+    val pageCount: Int
+
+    /**
+     * Produce the bitmap for the 0-based page [index]. Called from a
+     * coroutine tied to the container; switch to a background dispatcher
+     * for decoding or rendering. Cancelled if the page falls out of the
+     * window before it finishes.
+     */
+    suspend fun loadPage(index: Int): Bitmap
+
+    /**
+     * Variant of [loadPage] used when the container was given a
+     * [PageBitmapPool]: decode via [PageBitmapPool.configure] or render into
+     * [PageBitmapPool.get] to reuse the pixel memory of evicted pages.
+     * Defaults to [loadPage].
+     */
+    suspend fun loadPage(index: Int, pool: PageBitmapPool): Bitmap = loadPage(index)
+
+    /**
+     * The container no longer draws the bitmap previously loaded for
+     * [index]. Without a [PageBitmapPool] the source may recycle or cache
+     * it; with one, the bitmap has been handed to the pool and must not be
+     * touched.
+     */
+    fun release(index: Int) {}
+
+    /**
+     * A cheap low-resolution stand-in for [index], returned synchronously
+     * (e.g. from a thumbnail cache), or null if none is at hand. Drawn while
+     * the full page is still loading.
+     */
+    fun placeholder(index: Int): Bitmap? = null
+
+    /**
+     * Ranges of 0-based pages whose content changed, collected while the
+     * container is shown. Appended pages are announced by emitting their
+     * range after [pageCount] has grown; removed ones by emitting the range
+     * past the new [pageCount]. Cached copies of the pages in a range are
+     * reloaded if they are near the current page and dropped otherwise.
+     */
+    val invalidations: Flow<IntRange> get() = emptyFlow()
+}
+
+/**
+ * Page lookup used by the container's renderer and gestures, backed either
+ * by a caller-supplied list or by a lazily loaded [PageSource] window.
+ */
+internal interface PageProvider {
+    val pageCount: Int
+
+    /** The bitmap for [index] if it is available to draw right now. */
+    operator fun get(index: Int): Bitmap?
+
+    /**
+     * Start making the [step] pages shown from [current] (1, or 2 for a
+     * spread) and the pages around them available. Never blocks.
+     *
+     * @param warm A prefetch that is not a page change, e.g. where a jump
+     *             will land; it is not counted as a turn.
+     */
+    fun prepare(current: Int, step: Int = 1, warm: Boolean = false) {}
+
+    /** Bytes of page bitmaps held for drawing. */
+    val residentBytes: Long get() = 0L
+
+    /** Shrink what is held for a `ComponentCallbacks2.TRIM_MEMORY_*` [level]. */
+    fun trimMemory(level: Int) {}
+
+    /**
+     * Return evicted bitmaps to the bitmap pool once nothing draws them.
+     * Called at the start of every draw pass; [held] reports the bitmaps a
+     * recorded layer or shader still references.
+     */
+    fun recycleRetired(held: (Bitmap) -> Boolean) {}
+}
+
+/**
+ * [PageProvider] over pre-rendered bitmaps. The caller owns them, so
+ * nothing can be trimmed; [residentBytes] reports the whole list.
+ */
+internal class ListPageProvider(private val pages: List<Bitmap>) : PageProvider {
+    override val pageCount: Int get() = pages.size
+    override fun get(index: Int): Bitmap? = pages.getOrNull(index)
+
+    override val residentBytes: Long
+        get() {
+            var bytes = 0L
+            for (i in pages.indices) bytes += pages[i].allocationByteCount
+            return bytes
+        }
+}
+
+/** [PageProvider] for composable pages, which are drawn from layers rather than bitmaps. */
+internal class ContentPageProvider(override val pageCount: Int) : PageProvider {
+    override fun get(index: Int): Bitmap? = null
+}
@@ -0,0 +1,32 @@
+package io.github.readmigo.pagecurl
+
+/**
+ * How many pages [PageCurlContainer] shows side by side.
+ *
+ * In a two-page spread the pages are paired `(0, 1), (2, 3), ...`: a
+ * forward turn curls the right leaf over to the left, a backward turn the
+ * left leaf over to the right, and each turn advances two pages. Only the
+ * turning leaf runs through the curl geometry, sized to one half of the
+ * container; the facing page is a plain bitmap draw.
+ */
+enum class PageSpread {
+    /** One page filling the container. */
+    SINGLE,
+
+    /** Two pages side by side. */
+    DOUBLE,
+
+    /** [DOUBLE] when the container is landscape and at least 600 dp wide, else [SINGLE]. */
+    AUTO;
+
+    /** Whether a container of this size shows two pages. */
+    internal fun isTwoUp(width: Float, height: Float, density: Float): Boolean = when (this) {
+        SINGLE -> false
+        DOUBLE -> true
+        AUTO -> width > height && width >= AUTO_MIN_WIDTH_DP * density
+    }
+
+    private companion object {
+        const val AUTO_MIN_WIDTH_DP = 600
+    }
+}
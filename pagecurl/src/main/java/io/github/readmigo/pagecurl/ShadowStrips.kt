@@ -0,0 +1,113 @@
+package io.github.readmigo.pagecurl
+
+import android.graphics.Bitmap
+import android.graphics.BitmapShader
+import android.graphics.Canvas
+import android.graphics.Color
+import android.graphics.Paint
+import android.graphics.Shader
+
+/**
+ * The fold's shadow and highlight bands drawn as one textured strip mesh.
+ *
+ * The three profiles (cast shadow, crease shadow, cylinder highlight) are
+ * baked once into a small ramp bitmap, one [SEGMENT]-texel segment each,
+ * behind a single [BitmapShader]. Every band's polygon from [CurlFrame] is
+ * fanned into triangles whose texture coordinate is the vertex's distance
+ * from the fold line over the band width, mapped into its segment; the
+ * distance is affine in position, so interpolating it across a triangle is
+ * exact. All bands then go out in a single `drawVertices` call, with no
+ * per-frame shader or clip work.
+ *
+ * `drawVertices` ignores anti-aliasing, so the mesh is the same at every
+ * [CurlQuality] tier.
+ */
+internal class ShadowStrips {
+
+    private val shader = BitmapShader(bakeRamp(), Shader.TileMode.CLAMP, Shader.TileMode.CLAMP)
+    private val paint = Paint(Paint.FILTER_BITMAP_FLAG).apply {
+        shader = this@ShadowStrips.shader
+    }
+
+    // Three bands of at most MAX_POLYGON_VERTICES points, fanned into triangles
+    private val verts = FloatArray(MAX_POINTS * 2)
+    private val texs = FloatArray(MAX_POINTS * 2)
+    private var points = 0
+
+    /** Draws the selected bands of [frame] in one call. */
+    fun draw(canvas: Canvas, frame: CurlFrame, cast: Boolean, crease: Boolean, highlight: Boolean) {
+        points = 0
+        if (cast) {
+            addBand(frame, frame.shadowVerts, frame.shadowVertexCount, 1f, frame.castShadowWidth, CAST)
+        }
+        if (crease) {
+            addBand(frame, frame.creaseVerts, frame.creaseVertexCount, -1f, frame.creaseShadowWidth, CREASE)
+        }
+        if (highlight) {
+            addBand(frame, frame.curlStripVerts, frame.curlStripVertexCount, 1f, frame.curlStripWidth, HIGHLIGHT)
+        }
+        if (points == 0) return
+        canvas.drawVertices(
+            Canvas.VertexMode.TRIANGLES, points * 2,
+            verts, 0, texs, 0, null, 0, null, 0, 0, paint
+        )
+    }
+
+    // Fans the convex band polygon; side is +1 on the curl side, -1 on the flat side
+    private fun addBand(frame: CurlFrame, poly: FloatArray, count: Int, side: Float, width: Float, segment: Int) {
+        if (count < 3 || width <= 0f) return
+        for (i in 1 until count - 1) {
+            addVertex(frame, poly, 0, side, width, segment)
+            addVertex(frame, poly, i, side, width, segment)
+            addVertex(frame, poly, i + 1, side, width, segment)
+        }
+    }
+
+    private fun addVertex(frame: CurlFrame, poly: FloatArray, index: Int, side: Float, width: Float, segment: Int) {
+        val x = poly[index * 2]
+        val y = poly[index * 2 + 1]
+        val distance = ((x - frame.foldX) * frame.normalX + (y - frame.foldY) * frame.normalY) * side
+        val t = (distance / width).coerceIn(0f, 1f)
+        val slot = points * 2
+        verts[slot] = x
+        verts[slot + 1] = y
+        // Texel centres only, so filtering never reads the neighbouring segment
+        texs[slot] = segment * SEGMENT + 0.5f + t * (SEGMENT - 1)
+        texs[slot + 1] = 0.5f
+        points++
+    }
+
+    private companion object {
+        /** Texels per profile. */
+        const val SEGMENT = 64
+        const val CAST = 0
+        const val CREASE = 1
+        const val HIGHLIGHT = 2
+        const val MAX_POINTS = 3 * (CurlFrame.MAX_POLYGON_VERTICES - 2) * 3
+
+        /** The profiles of [CurlFrame]'s gradients, sampled from the fold (t = 0) outward. */
+        fun bakeRamp(): Bitmap {
+            val ramp = Bitmap.createBitmap(SEGMENT * 3, 1, Bitmap.Config.ARGB_8888)
+            for (i in 0 until SEGMENT) {
+                val t = i / (SEGMENT - 1f)
+                ramp.setPixel(CAST * SEGMENT + i, 0, Color.argb(lerp(CurlMath.CAST_SHADOW_ALPHA, 0, t), 0, 0, 0))
+                ramp.setPixel(CREASE * SEGMENT + i, 0, Color.argb(lerp(CurlMath.CREASE_SHADOW_ALPHA, 0, t), 0, 0, 0))
+                ramp.setPixel(HIGHLIGHT * SEGMENT + i, 0, highlightAt(t))
+            }
+            return ramp
+        }
+
+        // Bright at the fold, neutral at 35 %, shadowed at the outer edge
+        fun highlightAt(t: Float): Int = if (t < HIGHLIGHT_MID) {
+            val u = t / HIGHLIGHT_MID
+            Color.argb(lerp(60, 0, u), lerp(255, 128, u), lerp(255, 128, u), lerp(255, 128, u))
+        } else {
+            val u = (t - HIGHLIGHT_MID) / (1f - HIGHLIGHT_MID)
+            Color.argb(lerp(0, 80, u), lerp(128, 0, u), lerp(128, 0, u), lerp(128, 0, u))
+        }
+
+        const val HIGHLIGHT_MID = 0.35f
+
+        fun lerp(from: Int, to: Int, t: Float): Int = (from + (to - from) * t + 0.5f).toInt()
+    }
+}
@@ -0,0 +1,164 @@
+package io.github.readmigo.pagecurl
+
+import androidx.compose.animation.core.FastOutSlowInEasing
+import androidx.compose.runtime.getValue
+import androidx.compose.runtime.mutableFloatStateOf
+import androidx.compose.runtime.mutableStateOf
+import androidx.compose.runtime.setValue
+import androidx.compose.runtime.withFrameNanos
+import kotlinx.coroutines.channels.Channel
+import kotlin.math.exp
+
+/**
+ * Frame-clock driven page-turn animation, one instance per container.
+ *
+ * A single long-lived [run] loop advances whichever turn is in flight, so
+ * starting, queueing or retargeting a turn only writes a few primitive
+ * fields: no coroutine, job or animation object per turn. The animated
+ * corner moves in a straight line from ([startX], [startY]) to
+ * ([endX], [endY]); completions ease with [FastOutSlowInEasing] over
+ * [COMPLETE_MILLIS], snap-backs follow a critically damped spring.
+ *
+ * Turns requested while one is in flight are counted in [queued] (positive
+ * forward, negative backward) and started by the container, through the
+ * `onNext` callback, as each turn finishes.
+ */
+internal class TurnEngine {
+
+    /** Animation progress, 0..1; the only state the draw pass observes. */
+    var progress by mutableFloatStateOf(0f)
+        private set
+    var isRunning by mutableStateOf(false)
+        private set
+
+    /** Direction of the turn in flight (or the last one). */
+    var forward = true
+        private set
+    /** Whether the turn in flight ends with the page turned (false: snaps back). */
+    var completing = false
+        private set
+
+    var startX = 0f
+        private set
+    var startY = 0f
+        private set
+    var endX = 0f
+        private set
+    var endY = 0f
+        private set
+
+    /** Turns waiting behind the one in flight: positive forward, negative backward. */
+    var queued = 0
+
+    /** Corner position at the current progress. */
+    val cornerX: Float get() = startX + (endX - startX) * progress
+    val cornerY: Float get() = startY + (endY - startY) * progress
+
+    private var startNanos = -1L
+    private val wake = Channel<Unit>(Channel.CONFLATED)
+
+    // Set by run; the frame callback is allocated once
+    private var onFinished: (forward: Boolean, completed: Boolean) -> Unit = { _, _ -> }
+    private var onNext: (forward: Boolean) -> Unit = {}
+    private val frameCallback: (Long) -> Unit = { now -> step(now) }
+
+    /** Starts a turn from the start point, replacing any turn in flight. */
+    fun start(forward: Boolean, completing: Boolean, startX: Float, startY: Float, endX: Float, endY: Float) {
+        this.forward = forward
+        this.completing = completing
+        this.startX = startX
+        this.startY = startY
+        this.endX = endX
+        this.endY = endY
+        startNanos = -1L
+        progress = 0f
+        isRunning = true
+        wake.trySend(Unit)
+    }
+
+    /**
+     * Sends the turn in flight to a new end point from wherever the corner
+     * is now, e.g. reversing a completion into a snap-back.
+     */
+    fun retarget(completing: Boolean, endX: Float, endY: Float) {
+        start(forward, completing, cornerX, cornerY, endX, endY)
+    }
+
+    /**
+     * Stops the turn in flight with the corner where it is, so a drag can
+     * take it over, and drops the queue.
+     * @return false if no turn was in flight.
+     */
+    fun grab(): Boolean {
+        queued = 0
+        if (!isRunning) return false
+        // Freeze the corner: the current position becomes both endpoints
+        val x = cornerX
+        val y = cornerY
+        startX = x
+        startY = y
+        endX = x
+        endY = y
+        isRunning = false
+        return true
+    }
+
+    /**
+     * Drives turns until cancelled; call once from the container's effect.
+     *
+     * @param onFinished Called when a turn reaches its end point.
+     * @param onNext     Called after [onFinished] with the direction of the
+     *                   next queued turn, already taken off [queued]; it is
+     *                   expected to [start] that turn or clear the queue.
+     */
+    suspend fun run(
+        onFinished: (forward: Boolean, completed: Boolean) -> Unit,
+        onNext: (forward: Boolean) -> Unit
+    ) {
+        this.onFinished = onFinished
+        this.onNext = onNext
+        while (true) {
+            if (!isRunning) {
+                wake.receive()
+                continue
+            }
+            withFrameNanos(frameCallback)
+        }
+    }
+
+    private fun step(now: Long) {
+        if (!isRunning) return
+        if (startNanos < 0L) startNanos = now
+        val elapsed = now - startNanos
+        val done: Boolean
+        if (completing) {
+            val fraction = (elapsed / (COMPLETE_MILLIS * 1_000_000f)).coerceAtMost(1f)
+            progress = FastOutSlowInEasing.transform(fraction)
+            done = fraction >= 1f
+        } else {
+            // Critically damped spring toward 1: x(t) = 1 - (1 + wt) e^(-wt)
+            val wt = SPRING_OMEGA * elapsed / 1_000_000_000f
+            val remaining = (1f + wt) * exp(-wt)
+            done = remaining < SPRING_REST
+            progress = if (done) 1f else 1f - remaining
+        }
+        if (!done) return
+
+        isRunning = false
+        onFinished(forward, completing)
+        val next = queued
+        if (next != 0 && !isRunning) {
+            queued = if (next > 0) next - 1 else next + 1
+            onNext(next > 0)
+        }
+    }
+
+    companion object {
+        /** Duration of a completing turn. */
+        const val COMPLETE_MILLIS = 300
+        /** sqrt(Spring.StiffnessHigh): the snap-back the Animatable spring used. */
+        private const val SPRING_OMEGA = 100f
+        /** Remaining fraction at which the snap-back counts as settled (~90 ms). */
+        private const val SPRING_REST = 0.001f
+    }
+}
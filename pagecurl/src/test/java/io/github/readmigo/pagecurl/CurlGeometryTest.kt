@@ -0,0 +1,302 @@
+package io.github.readmigo.pagecurl
+
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertFalse
+import org.junit.Assert.assertTrue
+import org.junit.Test
+import kotlin.math.PI
+import kotlin.math.abs
+import kotlin.math.cos
+import kotlin.math.sin
+import kotlin.random.Random
+
+/**
+ * Host-side checks of the fold geometry core: fixed cases for the
+ * degenerate inputs, and a seeded fuzz over drag positions, corners and
+ * page sizes that checks every record for invariants the renderers rely on.
+ */
+class CurlGeometryTest {
+
+    private val record = FloatArray(CurlGeometry.RECORD_STRIDE)
+    private val scratch = FloatArray(CurlGeometry.SCRATCH_SIZE)
+
+    // ---- Degenerate inputs ----
+
+    @Test
+    fun touchOnCornerIsFlat() {
+        assertFalse(compute(1000f, 1000f, 1000f, 1000f, 1000f, 1000f))
+        assertFlat(1000f, 1000f)
+    }
+
+    @Test
+    fun touchWithinMinCurlDistanceIsFlat() {
+        val d = CurlGeometry.MIN_CURL_DISTANCE / 2f
+        assertFalse(compute(1000f - d, 1000f, 1000f, 1000f, 1000f, 1000f))
+        assertFlat(1000f, 1000f)
+    }
+
+    @Test
+    fun nanTouchIsFlat() {
+        assertFalse(compute(Float.NaN, 500f, 1080f, 2400f, 1080f, 2400f))
+        assertFlat(1080f, 2400f)
+        assertFalse(compute(500f, Float.NaN, 1080f, 2400f, 1080f, 2400f))
+        assertFlat(1080f, 2400f)
+    }
+
+    @Test
+    fun nanCornerIsFlat() {
+        assertFalse(compute(500f, 500f, Float.NaN, 2400f, 1080f, 2400f))
+        assertEquals(0f, record[CurlGeometry.VISIBLE])
+        for (slot in SLOTS) assertEquals(0, count(slot))
+    }
+
+    @Test
+    fun infiniteTouchIsFlat() {
+        assertFalse(compute(Float.POSITIVE_INFINITY, 500f, 1080f, 2400f, 1080f, 2400f))
+        assertFlat(1080f, 2400f)
+    }
+
+    @Test
+    fun foldThroughTwoPageCorners() {
+        // Bottom-right corner dragged onto the top-left: the fold is the other diagonal
+        assertTrue(compute(0f, 0f, 1000f, 1000f, 1000f, 1000f))
+        assertRecordSane(0f, 0f, 1000f, 1000f, 1000f, 1000f, "diagonal fold")
+        assertEquals(500_000.0, area(CurlGeometry.CURL), 1e-3)
+        assertEquals(500_000.0, area(CurlGeometry.FLAT), 1e-3)
+    }
+
+    @Test
+    fun foldThroughOppositeCorner() {
+        // |touch - TL| == |corner - TL| == 500, so the fold passes through TL
+        assertTrue(compute(0f, 500f, 300f, 400f, 300f, 400f))
+        assertRecordSane(0f, 500f, 300f, 400f, 300f, 400f, "fold through TL")
+    }
+
+    @Test
+    fun foldAlongPageEdge() {
+        // The fold line lies on the left edge; the whole page is lifted
+        assertTrue(compute(-1080f, 2400f, 1080f, 2400f, 1080f, 2400f))
+        assertRecordSane(-1080f, 2400f, 1080f, 2400f, 1080f, 2400f, "fold on edge")
+        assertEquals(1080.0 * 2400.0, area(CurlGeometry.CURL), 1e-2)
+    }
+
+    @Test
+    fun verticalFoldHalvesPage() {
+        assertTrue(compute(0f, 2400f, 1080f, 2400f, 1080f, 2400f))
+        assertRecordSane(0f, 2400f, 1080f, 2400f, 1080f, 2400f, "vertical fold")
+        assertEquals(4, count(CurlGeometry.CURL))
+        assertEquals(540.0 * 2400.0, area(CurlGeometry.CURL), 1e-2)
+    }
+
+    // ---- clipHalfPlane ----
+
+    @Test
+    fun clipEdgeParallelLine() {
+        val rect = floatArrayOf(0f, 0f, 100f, 0f, 100f, 50f, 0f, 50f)
+        val out = FloatArray(16)
+        val n = CurlGeometry.clipHalfPlane(rect, 4, 40f, 0f, 1f, 0f, out)
+        assertEquals(4, n)
+        assertEquals(60.0 * 50.0, polygonArea(out, 0, n), 1e-3)
+    }
+
+    @Test
+    fun clipLineMissingPolygon() {
+        val rect = floatArrayOf(0f, 0f, 100f, 0f, 100f, 50f, 0f, 50f)
+        val out = FloatArray(16)
+        assertEquals(0, CurlGeometry.clipHalfPlane(rect, 4, 200f, 0f, 1f, 0f, out))
+        assertEquals(4, CurlGeometry.clipHalfPlane(rect, 4, -200f, 0f, 1f, 0f, out))
+    }
+
+    @Test
+    fun clipWithOffsetsMatchesPlainClip() {
+        val rect = floatArrayOf(9f, 9f, 0f, 0f, 100f, 0f, 100f, 50f, 0f, 50f)
+        val plain = FloatArray(16)
+        val offset = FloatArray(20)
+        val n = CurlGeometry.clipHalfPlane(rect.copyOfRange(2, 10), 4, 30f, 20f, 0.6f, 0.8f, plain)
+        val m = CurlGeometry.clipHalfPlane(rect, 2, 4, 30f, 20f, 0.6f, 0.8f, offset, 4)
+        assertEquals(n, m)
+        for (i in 0 until n * 2) assertEquals(plain[i], offset[4 + i], 0f)
+    }
+
+    @Test
+    fun fuzzClipCounts() {
+        // One clip of a rectangle adds at most one vertex, two parallel clips two
+        val random = Random(SEED)
+        val out = FloatArray(32)
+        val strip = FloatArray(32)
+        repeat(ITERATIONS) {
+            val w = random.nextFloat() * 4000f + 1f
+            val h = random.nextFloat() * 4000f + 1f
+            val rect = floatArrayOf(0f, 0f, w, 0f, w, h, 0f, h)
+            val px = (random.nextFloat() * 3f - 1f) * w
+            val py = (random.nextFloat() * 3f - 1f) * h
+            val angle = random.nextDouble(0.0, 2.0 * PI)
+            val nx = cos(angle).toFloat()
+            val ny = sin(angle).toFloat()
+            val n = CurlGeometry.clipHalfPlane(rect, 4, px, py, nx, ny, out)
+            assertTrue("single clip gave $n vertices", n <= 5)
+            val width = random.nextFloat() * w
+            val m = CurlGeometry.clipHalfPlane(out, 0, n, px + nx * width, py + ny * width, -nx, -ny, strip, 0)
+            assertTrue("band clip gave $m vertices", m <= CurlGeometry.MAX_POLYGON_VERTICES)
+        }
+    }
+
+    // ---- Fuzz ----
+
+    @Test
+    fun fuzzRecords() {
+        val random = Random(SEED)
+        var visible = 0
+        repeat(ITERATIONS) { i ->
+            // Fractional and whole-pixel page sizes; whole pixels line folds up with corners
+            val w = if (random.nextInt(5) == 0) random.nextInt(1, 4001).toFloat() else random.nextFloat() * 4000f + 1f
+            val h = if (random.nextInt(5) == 0) random.nextInt(1, 4001).toFloat() else random.nextFloat() * 4000f + 1f
+            val corner = random.nextInt(4)
+            val cornerX = if (corner < 2) w else 0f
+            val cornerY = if (corner % 2 == 0) 0f else h
+            val touchX: Float
+            val touchY: Float
+            when (random.nextInt(10)) {
+                // Near the corner, around MIN_CURL_DISTANCE
+                0 -> {
+                    touchX = cornerX + random.nextFloat() * 4f - 2f
+                    touchY = cornerY + random.nextFloat() * 4f - 2f
+                }
+                // Whole pixels
+                1, 2 -> {
+                    touchX = random.nextInt(-w.toInt(), 2 * w.toInt() + 1).toFloat()
+                    touchY = random.nextInt(-h.toInt(), 2 * h.toInt() + 1).toFloat()
+                }
+                else -> {
+                    touchX = (random.nextFloat() * 3f - 1f) * w
+                    touchY = (random.nextFloat() * 3f - 1f) * h
+                }
+            }
+            val message = "#$i touch=($touchX, $touchY) corner=($cornerX, $cornerY) page=${w}x$h"
+            if (compute(touchX, touchY, cornerX, cornerY, w, h)) visible++
+            assertRecordSane(touchX, touchY, cornerX, cornerY, w, h, message)
+        }
+        // The sweep must actually exercise curled frames
+        assertTrue("only $visible visible frames", visible > ITERATIONS / 2)
+    }
+
+    // ---- Helpers ----
+
+    private fun compute(touchX: Float, touchY: Float, cornerX: Float, cornerY: Float, w: Float, h: Float): Boolean {
+        // Sentinel, so a field the core forgets to write shows up
+        record.fill(Float.NaN)
+        return CurlGeometry.computeInto(
+            record, 0,
+            touchX, touchY, cornerX, cornerY,
+            w, h,
+            w * CurlMath.CAST_SHADOW_FRACTION,
+            w * CurlMath.CREASE_SHADOW_FRACTION,
+            w * CurlMath.CURL_STRIP_FRACTION,
+            scratch
+        )
+    }
+
+    private fun assertFlat(cornerX: Float, cornerY: Float) {
+        assertEquals(0f, record[CurlGeometry.VISIBLE])
+        assertEquals(cornerX, record[CurlGeometry.CORNER_X])
+        assertEquals(cornerY, record[CurlGeometry.CORNER_Y])
+        for (i in 0 until CurlGeometry.RECORD_STRIDE) {
+            if (i != CurlGeometry.CORNER_X && i != CurlGeometry.CORNER_Y) assertEquals("field $i", 0f, record[i])
+        }
+    }
+
+    /** The invariants of the last computed record, for input finite enough to give one. */
+    private fun assertRecordSane(
+        touchX: Float, touchY: Float, cornerX: Float, cornerY: Float,
+        w: Float, h: Float, message: String
+    ) {
+        for (i in 0 until CurlGeometry.RECORD_STRIDE) {
+            assertFalse("$message: field $i is NaN", record[i].isNaN())
+        }
+        for (slot in SLOTS) {
+            val raw = record[CurlGeometry.polygonOffset(0, slot)]
+            assertEquals("$message: slot $slot count", raw.toInt().toFloat(), raw)
+            val n = count(slot)
+            assertTrue("$message: slot $slot has $n vertices", n in 0..CurlGeometry.MAX_POLYGON_VERTICES)
+        }
+        if (record[CurlGeometry.VISIBLE] == 0f) {
+            for (slot in SLOTS) assertEquals("$message: flat frame slot $slot", 0, count(slot))
+            return
+        }
+        assertEquals(message, 1f, record[CurlGeometry.VISIBLE])
+        assertTrue("$message: curl region has ${count(CurlGeometry.CURL)} vertices", count(CurlGeometry.CURL) >= 3)
+
+        val scale = w + h
+        // Every vertex lies on the page
+        for (slot in SLOTS) {
+            val base = CurlGeometry.polygonOffset(0, slot) + 1
+            for (v in 0 until count(slot)) {
+                val x = record[base + v * 2]
+                val y = record[base + v * 2 + 1]
+                assertTrue("$message: slot $slot vertex ($x, $y) off the page",
+                    x >= -EPSILON * scale && x <= w + EPSILON * scale &&
+                        y >= -EPSILON * scale && y <= h + EPSILON * scale)
+            }
+        }
+
+        // The fold splits the page: flat and curl areas add up to the page
+        val total = area(CurlGeometry.FLAT) + area(CurlGeometry.CURL)
+        val pageArea = w.toDouble() * h
+        assertEquals("$message: flat + curl area", pageArea, total, pageArea * 1e-4 + 1e-3)
+
+        // Bands stay within their width of the fold, on their side
+        assertBand(CurlGeometry.CAST_SHADOW, 1f, w * CurlMath.CAST_SHADOW_FRACTION, message)
+        assertBand(CurlGeometry.CREASE, -1f, w * CurlMath.CREASE_SHADOW_FRACTION, message)
+        assertBand(CurlGeometry.CURL_STRIP, 1f, w * CurlMath.CURL_STRIP_FRACTION, message)
+
+        // The normal is unit length and the reflection takes the corner to the touch point
+        val nx = record[CurlGeometry.NORMAL_X]
+        val ny = record[CurlGeometry.NORMAL_Y]
+        assertEquals("$message: normal length", 1f, nx * nx + ny * ny, 1e-4f)
+        val m = CurlGeometry.MATRIX
+        val rx = record[m] * cornerX + record[m + 1] * cornerY + record[m + 2]
+        val ry = record[m + 3] * cornerX + record[m + 4] * cornerY + record[m + 5]
+        assertEquals("$message: reflected corner x", touchX, rx, 1e-4f * scale + 1e-3f)
+        assertEquals("$message: reflected corner y", touchY, ry, 1e-4f * scale + 1e-3f)
+    }
+
+    private fun assertBand(slot: Int, side: Float, width: Float, message: String) {
+        val mx = record[CurlGeometry.FOLD_X]
+        val my = record[CurlGeometry.FOLD_Y]
+        val nx = record[CurlGeometry.NORMAL_X]
+        val ny = record[CurlGeometry.NORMAL_Y]
+        val base = CurlGeometry.polygonOffset(0, slot) + 1
+        val tolerance = 1e-5f * (abs(mx) + abs(my) + width) + 1e-3f
+        for (v in 0 until count(slot)) {
+            val d = ((record[base + v * 2] - mx) * nx + (record[base + v * 2 + 1] - my) * ny) * side
+            assertTrue("$message: slot $slot vertex at $d from the fold, band $width",
+                d >= -tolerance && d <= width + tolerance)
+        }
+    }
+
+    private fun count(slot: Int): Int = record[CurlGeometry.polygonOffset(0, slot)].toInt()
+
+    private fun area(slot: Int): Double =
+        polygonArea(record, CurlGeometry.polygonOffset(0, slot) + 1, count(slot))
+
+    /** Shoelace area, in doubles so the sum itself adds no error. */
+    private fun polygonArea(points: FloatArray, from: Int, count: Int): Double {
+        var sum = 0.0
+        for (i in 0 until count) {
+            val j = (i + 1) % count
+            sum += points[from + i * 2].toDouble() * points[from + j * 2 + 1] -
+                points[from + j * 2].toDouble() * points[from + i * 2 + 1]
+        }
+        return abs(sum) / 2.0
+    }
+
+    private companion object {
+        const val SEED = 0x5EED
+        const val ITERATIONS = 20_000
+        const val EPSILON = 1e-5f
+        val SLOTS = intArrayOf(
+            CurlGeometry.FLAT, CurlGeometry.CURL, CurlGeometry.CAST_SHADOW,
+            CurlGeometry.CREASE, CurlGeometry.CURL_STRIP
+        )
+    }
+}
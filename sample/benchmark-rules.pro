@@ -0,0 +1,2 @@
+# Keep class names readable so generated Baseline Profiles match the library
+-dontobfuscate
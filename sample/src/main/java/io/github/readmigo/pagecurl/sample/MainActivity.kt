@@ -0,0 +1,71 @@
+package io.github.readmigo.pagecurl.sample
+
+import android.graphics.Bitmap
+import android.graphics.Canvas
+import android.graphics.Color
+import android.graphics.Paint
+import android.os.Bundle
+import androidx.activity.ComponentActivity
+import androidx.activity.compose.setContent
+import androidx.compose.foundation.layout.BoxWithConstraints
+import androidx.compose.foundation.layout.fillMaxSize
+import androidx.compose.runtime.remember
+import androidx.compose.ui.Modifier
+import androidx.compose.ui.platform.LocalDensity
+import io.github.readmigo.pagecurl.CurlRenderer
+import io.github.readmigo.pagecurl.PageCurlContainer
+
+/**
+ * Minimal reader used by the macrobenchmarks: a handful of generated text
+ * pages in a [PageCurlContainer].
+ *
+ * The renderer can be picked with the `renderer` intent extra
+ * (`canvas`, `mesh` or `cylinder`).
+ */
+class MainActivity : ComponentActivity() {
+
+    override fun onCreate(savedInstanceState: Bundle?) {
+        super.onCreate(savedInstanceState)
+        val renderer = when (intent.getStringExtra(EXTRA_RENDERER)) {
+            "mesh" -> CurlRenderer.Mesh
+            "cylinder" -> CurlRenderer.Cylinder()
+            else -> CurlRenderer.Canvas
+        }
+        setContent {
+            BoxWithConstraints(Modifier.fillMaxSize()) {
+                val density = LocalDensity.current
+                val width = with(density) { maxWidth.roundToPx() }
+                val height = with(density) { maxHeight.roundToPx() }
+                val pages = remember(width, height) { renderPages(PAGE_COUNT, width, height) }
+                PageCurlContainer(pages = pages, renderer = renderer)
+            }
+        }
+    }
+
+    private fun renderPages(count: Int, width: Int, height: Int): List<Bitmap> {
+        if (width <= 0 || height <= 0) return emptyList()
+        val text = Paint(Paint.ANTI_ALIAS_FLAG).apply {
+            color = Color.DKGRAY
+            textSize = width / 24f
+        }
+        val lineHeight = text.textSize * 1.5f
+        val margin = width / 12f
+        return List(count) { index ->
+            Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888).also { bitmap ->
+                val canvas = Canvas(bitmap)
+                canvas.drawColor(Color.rgb(250, 246, 238))
+                var y = margin + lineHeight
+                var line = 0
+                while (y < height - margin) {
+                    canvas.drawText("Page ${index + 1} · line ${++line} of sample text", margin, y, text)
+                    y += lineHeight
+                }
+            }
+        }
+    }
+
+    companion object {
+        const val EXTRA_RENDERER = "renderer"
+        private const val PAGE_COUNT = 20
+    }
+}
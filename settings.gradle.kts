@@ -22,3 +22,6 @@ dependencyResolutionManagement {
 
 rootProject.name = "android-page-curl"
 include(":pagecurl")
+include(":benchmark")
+include(":sample")
+include(":macrobenchmark")